@@ -0,0 +1,98 @@
+/*
+ * yasmic
+ * 2026
+ */
+
+/**
+ * @file kcore_perf.cc
+ * Performance test of the serial and parallel core decompositions.
+ *
+ * Usage: kcore_perf graph1.txt [graph2.txt ...]
+ * where each file is in the text format read by ifstream_as_matrix.hpp:
+ * a header line "nrows ncols nnz" followed by one "row col value" line
+ * per nonzero.  The graph is symmetrized, and duplicate edges and self
+ * loops are removed.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <algorithm>
+
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/simple_csr_matrix_as_graph.hpp>
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/parallel_core_numbers.hpp>
+#include <yasmic/boost_mod/core_numbers.hpp>
+
+int main(int argc, char **argv)
+{
+    using namespace std;
+    using namespace yasmic;
+
+    if (argc < 2)
+    {
+        return (-1);
+    }
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        string filename = argv[arg];
+        cout << "graph filename: " << filename << endl;
+
+        ifstream fs(filename.c_str());
+        int nr, nc, nz;
+        fs >> nr >> nc >> nz;
+        int n = max(nr, nc);
+
+        // read the edges in both directions
+        vector< pair<int,int> > edges;
+        edges.reserve(2*(size_t)nz);
+        for (int k = 0; k < nz; ++k)
+        {
+            int i, j;
+            double v;
+            fs >> i >> j >> v;
+            if (i == j) { continue; }
+            edges.push_back(make_pair(i, j));
+            edges.push_back(make_pair(j, i));
+        }
+        sort(edges.begin(), edges.end());
+        edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+        vector<int> rows(n+1, 0), cols(edges.size());
+        vector<double> vals(edges.size(), 1.0);
+        for (size_t k = 0; k < edges.size(); ++k)
+        {
+            ++rows[edges[k].first+1];
+            cols[k] = edges[k].second;
+        }
+        for (int i = 0; i < n; ++i) { rows[i+1] += rows[i]; }
+
+        simple_csr_matrix<int,double> g(n, n, (int)cols.size(),
+            &rows[0], &cols[0], &vals[0]);
+        cout << "vertices: " << n << " edges: " << cols.size()/2 << endl;
+
+        vector<int> cn(n), pcn(n);
+        double t0 = parallel_wtime();
+        int kmax = boost::core_numbers(g, boost::make_iterator_property_map(
+            cn.begin(), boost::get(boost::vertex_index, g)));
+        double t = parallel_wtime() - t0;
+        cout << "core_numbers (serial): " << t << " seconds, max core "
+             << kmax << endl;
+
+        for (int nthreads = 1; nthreads <= parallel_max_threads(); nthreads *= 2)
+        {
+            t0 = parallel_wtime();
+            parallel_core_numbers(g, pcn.begin(), nthreads);
+            t = parallel_wtime() - t0;
+            cout << "parallel_core_numbers (" << nthreads << " threads): "
+                 << t << " seconds" << (pcn == cn ? "" : " DIFFERENT CORES")
+                 << endl;
+        }
+    }
+
+    return (0);
+}
@@ -0,0 +1,291 @@
+/*
+ * yasmic
+ * 2026
+ */
+
+/**
+ * @file spmv_perf.cc
+ * Performance test of the sparse matrix-vector product kernels.
+ *
+ * Usage: spmv_perf matrix1.txt [matrix2.txt ...]
+ * where each file is in the text format read by ifstream_as_matrix.hpp:
+ * a header line "nrows ncols nnz" followed by one "row col value" line
+ * per nonzero.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <algorithm>
+
+#include <numeric>
+
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/parallel_matrix_operations.hpp>
+#include <yasmic/simd_csr_kernels.hpp>
+#include <yasmic/simple_row_and_column_matrix.hpp>
+#include <yasmic/csb_matrix.hpp>
+#include <yasmic/block_csr_matrix.hpp>
+#include <yasmic/sell_c_sigma_matrix.hpp>
+#include <yasmic/spmm_operations.hpp>
+
+#define MAX_TRY 50
+
+template <class Func>
+double time_kernel(Func f)
+{
+    double t0 = yasmic::parallel_wtime();
+    for (int ntry = 0; ntry < MAX_TRY; ntry++)
+    {
+        f();
+    }
+    return (yasmic::parallel_wtime() - t0)/MAX_TRY;
+}
+
+struct crm_mult_kernel
+{
+    typedef yasmic::compressed_row_matrix<
+        std::vector<int>::iterator, std::vector<int>::iterator,
+        std::vector<double>::iterator > crs_matrix;
+    const crs_matrix& m; const double* x; double* y;
+    crm_mult_kernel(const crs_matrix& m, const double* x, double* y)
+        : m(m), x(x), y(y) {}
+    void operator()() { mult(m, x, y); }
+};
+
+struct parallel_mult_kernel
+{
+    const yasmic::simple_csr_matrix<int,double>& m;
+    const double* x; double* y; int nthreads;
+    parallel_mult_kernel(const yasmic::simple_csr_matrix<int,double>& m,
+        const double* x, double* y, int nthreads)
+        : m(m), x(x), y(y), nthreads(nthreads) {}
+    void operator()() { yasmic::parallel_mult(m, x, y, nthreads); }
+};
+
+struct simd_mult_kernel
+{
+    const yasmic::simple_csr_matrix<int,double>& m;
+    const double* x; double* y; int nthreads; yasmic::simd_level level;
+    simd_mult_kernel(const yasmic::simple_csr_matrix<int,double>& m,
+        const double* x, double* y, int nthreads, yasmic::simd_level level)
+        : m(m), x(x), y(y), nthreads(nthreads), level(level) {}
+    void operator()() { yasmic::simd_mult(m, x, y, nthreads, level); }
+};
+
+struct csb_mult_kernel
+{
+    const yasmic::csb_matrix<int,double>& m;
+    const double* x; double* y; int nthreads; bool trans;
+    csb_mult_kernel(const yasmic::csb_matrix<int,double>& m,
+        const double* x, double* y, int nthreads, bool trans)
+        : m(m), x(x), y(y), nthreads(nthreads), trans(trans) {}
+    void operator()()
+    {
+        if (trans) { yasmic::parallel_trans_mult(m, x, y, nthreads); }
+        else { yasmic::parallel_mult(m, x, y, nthreads); }
+    }
+};
+
+/**
+ * The dual copy approach to A^T*x: walk the column structure of a
+ * simple_row_and_column_matrix, each column in parallel.
+ */
+struct dual_trans_mult_kernel
+{
+    const yasmic::simple_row_and_column_matrix<int,double>& m;
+    const double* x; double* y; int nthreads;
+    dual_trans_mult_kernel(
+        const yasmic::simple_row_and_column_matrix<int,double>& m,
+        const double* x, double* y, int nthreads)
+        : m(m), x(x), y(y), nthreads(nthreads) {}
+    void operator()()
+    {
+        int nc = m.ncols;
+        #pragma omp parallel for schedule(dynamic,256) num_threads(nthreads)
+        for (int c = 0; c < nc; ++c)
+        {
+            double sum = 0.0;
+            for (int k = m.ati[c]; k < m.ati[c+1]; ++k)
+            {
+                sum += m.a[m.atid[k]]*x[m.atj[k]];
+            }
+            y[c] = sum;
+        }
+    }
+};
+
+struct sell_mult_kernel
+{
+    const yasmic::sell_c_sigma_matrix<int,double>& m;
+    const double* x; double* y; int nthreads;
+    sell_mult_kernel(const yasmic::sell_c_sigma_matrix<int,double>& m,
+        const double* x, double* y, int nthreads)
+        : m(m), x(x), y(y), nthreads(nthreads) {}
+    void operator()() { yasmic::simd_mult(m, x, y, nthreads); }
+};
+
+struct spmm_kernel
+{
+    const yasmic::simple_csr_matrix<int,double>& m;
+    const double* x; double* y; int k; int nthreads;
+    spmm_kernel(const yasmic::simple_csr_matrix<int,double>& m,
+        const double* x, double* y, int k, int nthreads)
+        : m(m), x(x), y(y), k(k), nthreads(nthreads) {}
+    void operator()() { yasmic::spmm(m, x, y, k, nthreads); }
+};
+
+template <class BlockMatrix>
+struct bcsr_mult_kernel
+{
+    const BlockMatrix& m; const double* x; double* y; int nthreads;
+    bcsr_mult_kernel(const BlockMatrix& m, const double* x, double* y,
+        int nthreads)
+        : m(m), x(x), y(y), nthreads(nthreads) {}
+    void operator()() { yasmic::parallel_mult(m, x, y, nthreads); }
+};
+
+template <int R, int C, class Matrix>
+void time_bcsr(const Matrix& crm, const double* x, double* y, int nthreads)
+{
+    using namespace std;
+    yasmic::block_csr_matrix<int,double,R,C> b;
+    yasmic::build_bcsr_from_csr(crm, b);
+    double t = time_kernel(bcsr_mult_kernel<
+        yasmic::block_csr_matrix<int,double,R,C> >(b, x, y, nthreads));
+    cout << "bcsr " << R << "x" << C << " mult (" << nthreads << " threads, fill "
+         << b.fill_ratio() << "): " << t << " seconds" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    using namespace std;
+    using namespace yasmic;
+
+    if (argc < 2)
+    {
+        return (-1);
+    }
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        string filename = argv[arg];
+        cout << "matrix filename: " << filename << endl;
+
+        ifstream fs(filename.c_str());
+        int nr, nc, nz;
+        fs >> nr >> nc >> nz;
+
+        // read the triples and bucket them by row
+        vector<int> ti(nz), tj(nz);
+        vector<double> tv(nz);
+        vector<int> rows(nr+1);
+        vector<int> cols(nz);
+        vector<double> vals(nz);
+        for (int k = 0; k < nz; ++k)
+        {
+            fs >> ti[k] >> tj[k] >> tv[k];
+            ++rows[ti[k]+1];
+        }
+        partial_sum(rows.begin(), rows.end(), rows.begin());
+        {
+            vector<int> cur(rows.begin(), rows.end()-1);
+            for (int k = 0; k < nz; ++k)
+            {
+                cols[cur[ti[k]]] = tj[k];
+                vals[cur[ti[k]]] = tv[k];
+                ++cur[ti[k]];
+            }
+        }
+
+        cout << "nrows: " << nr << " ncols: " << nc << " nnz: " << nz << endl;
+
+        crm_mult_kernel::crs_matrix crm(rows.begin(), rows.end(),
+            cols.begin(), cols.end(), vals.begin(), vals.end(), nr, nc, nz);
+        simple_csr_matrix<int,double> csr(nr, nc, nz, &rows[0], &cols[0], &vals[0]);
+
+        vector<double> x(nc, 1.0), y(nr);
+        int nthreads = parallel_max_threads();
+
+        double t = time_kernel(crm_mult_kernel(crm, &x[0], &y[0]));
+        cout << "mult (template): " << t << " seconds" << endl;
+
+        t = time_kernel(parallel_mult_kernel(csr, &x[0], &y[0], nthreads));
+        cout << "parallel_mult (" << nthreads << " threads): "
+             << t << " seconds" << endl;
+
+        for (int level = simd_scalar; level <= simd_detect_level(); ++level)
+        {
+            t = time_kernel(simd_mult_kernel(csr, &x[0], &y[0], 1,
+                (simd_level)level));
+            cout << "simd_mult level " << level << ": " << t << " seconds" << endl;
+            t = time_kernel(simd_mult_kernel(csr, &x[0], &y[0], nthreads,
+                (simd_level)level));
+            cout << "simd_mult level " << level << " (" << nthreads
+                 << " threads): " << t << " seconds" << endl;
+        }
+
+        for (int sigma = 1; sigma <= nr; sigma *= 16)
+        {
+            sell_c_sigma_matrix<int,double> sell;
+            double pad = build_sell_from_csr(csr, sell, 8, sigma);
+            t = time_kernel(sell_mult_kernel(sell, &x[0], &y[0], nthreads));
+            cout << "sell-8-" << sigma << " simd_mult (" << nthreads
+                 << " threads, padding " << pad << "): " << t << " seconds" << endl;
+        }
+
+        // Y = A*X with k vectors against k calls to parallel_mult
+        for (int k = 4; k <= 16; k *= 2)
+        {
+            vector<double> X((size_t)nc*k, 1.0), Y((size_t)nr*k);
+            t = time_kernel(spmm_kernel(csr, &X[0], &Y[0], k, nthreads));
+            double tk = k*time_kernel(parallel_mult_kernel(csr, &x[0], &y[0], nthreads));
+            cout << "spmm k=" << k << " (" << nthreads << " threads): " << t
+                 << " seconds, " << k << " x parallel_mult: " << tk
+                 << " seconds" << endl;
+        }
+
+        // time the block size picked for the matrix, only the square
+        // blocks are instantiated here
+        {
+            int r, c;
+            choose_bcsr_block_size(crm, r, c);
+            cout << "bcsr block size: " << r << "x" << c << endl;
+            switch (r == c ? r : 1)
+            {
+                case 2: time_bcsr<2,2>(crm, &x[0], &y[0], nthreads); break;
+                case 3: time_bcsr<3,3>(crm, &x[0], &y[0], nthreads); break;
+                case 4: time_bcsr<4,4>(crm, &x[0], &y[0], nthreads); break;
+                default: time_bcsr<1,1>(crm, &x[0], &y[0], nthreads); break;
+            }
+        }
+
+        // compare A^T*x from the csb format against the dual copy
+        {
+            vector<int> ati(nc+1), atj(nz), atid(nz);
+            build_row_and_column_from_csr(csr, &ati[0], &atj[0], &atid[0]);
+            simple_row_and_column_matrix<int,double> rac(nr, nc, nz,
+                &rows[0], &cols[0], &vals[0], &ati[0], &atj[0], &atid[0]);
+
+            csb_matrix<int,double> csb;
+            build_csb_from_csr(csr, csb);
+            cout << "csb beta: " << (1 << csb.lg_beta) << endl;
+
+            vector<double> xt(nr, 1.0), yt(nc);
+            t = time_kernel(dual_trans_mult_kernel(rac, &xt[0], &yt[0], nthreads));
+            cout << "dual copy trans_mult (" << nthreads << " threads): "
+                 << t << " seconds" << endl;
+            t = time_kernel(csb_mult_kernel(csb, &x[0], &y[0], nthreads, false));
+            cout << "csb mult (" << nthreads << " threads): "
+                 << t << " seconds" << endl;
+            t = time_kernel(csb_mult_kernel(csb, &xt[0], &yt[0], nthreads, true));
+            cout << "csb trans_mult (" << nthreads << " threads): "
+                 << t << " seconds" << endl;
+        }
+    }
+
+    return (0);
+}
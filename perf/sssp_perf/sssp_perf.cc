@@ -0,0 +1,142 @@
+/*
+ * yasmic
+ * 2026
+ */
+
+/**
+ * @file sssp_perf.cc
+ * Performance test of delta-stepping against the serial Dijkstra and
+ * Bellman-Ford shortest paths.
+ *
+ * Usage: sssp_perf graph1.txt [graph2.txt ...]
+ * where each file is in the text format read by ifstream_as_matrix.hpp:
+ * a header line "nrows ncols nnz" followed by one "row col value" line
+ * per nonzero.  The graph is directed, the edge weights are the absolute
+ * values, and duplicate edges and self loops are removed.  Each code is
+ * timed from vertex 0 with double weights, and delta-stepping again with
+ * the weights rounded to integers.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <limits>
+#include <functional>
+#include <cmath>
+
+#include <algorithm>
+
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/simple_csr_matrix_as_graph.hpp>
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/delta_stepping_shortest_paths.hpp>
+#include <yasmic/boost_mod/bellman_ford_shortest_paths.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+int main(int argc, char **argv)
+{
+    using namespace std;
+    using namespace yasmic;
+
+    if (argc < 2)
+    {
+        return (-1);
+    }
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        string filename = argv[arg];
+        cout << "graph filename: " << filename << endl;
+
+        ifstream fs(filename.c_str());
+        int nr, nc, nz;
+        fs >> nr >> nc >> nz;
+        int n = max(nr, nc);
+
+        vector< pair< pair<int,int>, double> > edges;
+        edges.reserve(nz);
+        for (int k = 0; k < nz; ++k)
+        {
+            int i, j;
+            double v;
+            fs >> i >> j >> v;
+            if (i == j) { continue; }
+            edges.push_back(make_pair(make_pair(i, j), fabs(v)));
+        }
+        sort(edges.begin(), edges.end());
+        size_t m = 0;
+        for (size_t k = 0; k < edges.size(); ++k)
+        {
+            if (m > 0 && edges[m-1].first == edges[k].first) { continue; }
+            edges[m++] = edges[k];
+        }
+        edges.resize(m);
+
+        vector<int> rows(n+1, 0), cols(m), ivals(m);
+        vector<double> vals(m);
+        for (size_t k = 0; k < m; ++k)
+        {
+            ++rows[edges[k].first.first+1];
+            cols[k] = edges[k].first.second;
+            vals[k] = edges[k].second;
+            ivals[k] = (int)(vals[k] + 0.5);
+        }
+        for (int i = 0; i < n; ++i) { rows[i+1] += rows[i]; }
+
+        simple_csr_matrix<int,double> g(n, n, (int)m,
+            &rows[0], &cols[0], &vals[0]);
+        simple_csr_matrix<int,int> gi(n, n, (int)m,
+            &rows[0], &cols[0], &ivals[0]);
+        cout << "vertices: " << n << " edges: " << m << endl;
+
+        double inf = numeric_limits<double>::max();
+        vector<double> dd(n), bd(n, inf), d(n);
+        boost::dummy_property_map pred;
+
+        double t0 = parallel_wtime();
+        boost::dijkstra_shortest_paths(g, 0, pred,
+            boost::make_iterator_property_map(dd.begin(),
+                boost::get(boost::vertex_index, g)),
+            boost::get(boost::edge_weight, g),
+            boost::get(boost::vertex_index, g),
+            std::less<double>(), boost::closed_plus<double>(), inf, 0.0,
+            boost::default_dijkstra_visitor());
+        double t = parallel_wtime() - t0;
+        cout << "dijkstra_shortest_paths (serial): " << t << " seconds" << endl;
+
+        t0 = parallel_wtime();
+        bd[0] = 0.0;
+        boost::bellman_ford_shortest_paths(g, n,
+            boost::get(boost::edge_weight, g), pred,
+            boost::make_iterator_property_map(bd.begin(),
+                boost::get(boost::vertex_index, g)),
+            boost::closed_plus<double>(), std::less<double>(),
+            boost::default_bellman_visitor());
+        t = parallel_wtime() - t0;
+        cout << "bellman_ford_shortest_paths (serial): " << t << " seconds"
+             << (bd == dd ? "" : " DIFFERENT DISTANCES") << endl;
+
+        double delta = delta_stepping_delta(g);
+        int idelta = delta_stepping_delta(gi);
+        cout << "delta: " << delta << " integer delta: " << idelta << endl;
+        for (int nthreads = 1; nthreads <= parallel_max_threads(); nthreads *= 2)
+        {
+            t0 = parallel_wtime();
+            delta_stepping_shortest_paths(g, 0, d.begin(), delta, nthreads);
+            t = parallel_wtime() - t0;
+            cout << "delta_stepping_shortest_paths (" << nthreads << " threads): "
+                 << t << " seconds" << (d == dd ? "" : " DIFFERENT DISTANCES")
+                 << endl;
+
+            vector<int> di(n);
+            t0 = parallel_wtime();
+            delta_stepping_shortest_paths(gi, 0, di.begin(), idelta, nthreads);
+            t = parallel_wtime() - t0;
+            cout << "delta_stepping_shortest_paths int (" << nthreads
+                 << " threads): " << t << " seconds" << endl;
+        }
+    }
+
+    return (0);
+}
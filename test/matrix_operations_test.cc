@@ -0,0 +1,1524 @@
+/*
+ * yasmic
+ * 2026
+ */
+
+/**
+ * @file matrix_operations_test.cc
+ * Check the parallel and specialized matrix kernels against the
+ * serial mult and trans_mult on a random matrix with a few very dense
+ * rows.
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/parallel_matrix_operations.hpp>
+#include <yasmic/simd_csr_kernels.hpp>
+#include <yasmic/csb_matrix.hpp>
+#include <yasmic/block_csr_matrix.hpp>
+#include <yasmic/sell_c_sigma_matrix.hpp>
+#include <yasmic/dcsr_matrix.hpp>
+#include <yasmic/spmm_operations.hpp>
+#include <yasmic/spgemm_operations.hpp>
+#include <yasmic/semiring_operations.hpp>
+#include <yasmic/fused_matrix_operations.hpp>
+#include <yasmic/pagerank.hpp>
+#include <yasmic/ppr_push.hpp>
+#include <yasmic/sweep_cut.hpp>
+#include <yasmic/hk_relax.hpp>
+#include <yasmic/parallel_core_numbers.hpp>
+#include <yasmic/dynamic_core_numbers.hpp>
+#include <yasmic/truss_numbers.hpp>
+#include <yasmic/triangle_counts.hpp>
+#include <yasmic/parallel_betweenness_centrality.hpp>
+#include <yasmic/approximate_betweenness_centrality.hpp>
+#include <yasmic/blocked_floyd_warshall.hpp>
+#include <yasmic/delta_stepping_shortest_paths.hpp>
+#include <yasmic/simple_csr_matrix_as_graph.hpp>
+#include <yasmic/boost_mod/core_numbers.hpp>
+#include <yasmic/boost_mod/clustering_coefficients.hpp>
+#include <yasmic/boost_mod/betweenness_centrality.hpp>
+#include <yasmic/boost_mod/floyd_warshall_shortest.hpp>
+#include <yasmic/boost_mod/johnson_all_pairs_shortest.hpp>
+#include <yasmic/simple_row_and_column_matrix.hpp>
+
+// build a random csr matrix where row i has about 1+(n/(i+1)) nonzeros
+void random_power_law_csr(int nr, int nc, std::vector<int>& rows,
+    std::vector<int>& cols, std::vector<double>& vals)
+{
+    rows.resize(nr+1);
+    cols.clear();
+    vals.clear();
+    rows[0] = 0;
+    for (int i=0; i < nr; ++i)
+    {
+        int d = 1 + (nc/(4*(i+1)));
+        if (i % 7 == 3) { d = 0; }
+        for (int k=0; k < d; ++k)
+        {
+            cols.push_back(std::rand() % nc);
+            vals.push_back((double)(std::rand() % 1000)/1000.0 - 0.5);
+        }
+        rows[i+1] = (int)cols.size();
+    }
+}
+
+/**
+ * Build an undirected graph with n vertices and power law degrees,
+ * stored with both directions of each edge, sorted columns, no
+ * duplicate edges, and no self loops.
+ */
+void random_symmetric_graph(int n, std::vector<int>& rows,
+    std::vector<int>& cols, std::vector<double>& vals)
+{
+    std::vector< std::vector<int> > adj(n);
+    for (int i=0; i < n; ++i)
+    {
+        int d = 1 + (n/(8*(i+1)));
+        for (int k=0; k < d; ++k)
+        {
+            int j = std::rand() % n;
+            if (j == i) { continue; }
+            adj[i].push_back(j);
+            adj[j].push_back(i);
+        }
+    }
+    rows.resize(n+1);
+    cols.clear();
+    rows[0] = 0;
+    for (int i=0; i < n; ++i)
+    {
+        std::sort(adj[i].begin(), adj[i].end());
+        adj[i].erase(std::unique(adj[i].begin(), adj[i].end()), adj[i].end());
+        cols.insert(cols.end(), adj[i].begin(), adj[i].end());
+        rows[i+1] = (int)cols.size();
+    }
+    vals.assign(cols.size(), 1.0);
+}
+
+/**
+ * Count the triangles seen by a clustering_coefficients visitor.
+ */
+struct triangle_counter
+{
+    triangle_counter(std::size_t* c) : count(c) {}
+    template <class Vertex, class Graph>
+    void operator()(Vertex, Vertex, Vertex, const Graph&) { ++*count; }
+    std::size_t* count;
+};
+
+int check_vector(const char* name, const std::vector<double>& a,
+    const std::vector<double>& b, double tol)
+{
+    using namespace std;
+    double maxdiff = 0.0;
+    for (size_t i=0; i < a.size(); ++i)
+    {
+        maxdiff = max(maxdiff, fabs(a[i]-b[i]));
+    }
+    cout << name << ": max difference " << maxdiff << endl;
+    if (maxdiff > tol)
+    {
+        cout << name << ": FAILED" << endl;
+        return (1);
+    }
+    return (0);
+}
+
+// check a block_csr_matrix against the csr matrix it was built from
+template <class Matrix, class BlockMatrix>
+int check_bcsr(const char* name, const Matrix& crm, BlockMatrix& b,
+    const std::vector<double>& x, const std::vector<double>& xt,
+    const std::vector<double>& y, const std::vector<double>& yt)
+{
+    using namespace yasmic;
+    int nfailed = 0;
+    build_bcsr_from_csr(crm, b);
+    std::cout << name << " fill ratio " << b.fill_ratio() << std::endl;
+
+    std::vector<double> z(y.size()), zt(yt.size());
+    mult(b, x.begin(), z.begin());
+    nfailed += check_vector("bcsr mult", y, z, 1e-12);
+    trans_mult(b, xt.begin(), zt.begin());
+    nfailed += check_vector("bcsr trans_mult", yt, zt, 1e-12);
+    std::fill(z.begin(), z.end(), 0.0);
+    parallel_mult(b, &x[0], &z[0], 4);
+    nfailed += check_vector("bcsr parallel_mult", y, z, 1e-12);
+
+    // mult again through the row iterators
+    typename smatrix_traits<BlockMatrix>::row_iterator ri, riend;
+    for (boost::tie(ri, riend) = rows(b); ri != riend; ++ri)
+    {
+        typename smatrix_traits<BlockMatrix>::row_nonzero_iterator nzi, nziend;
+        double sum = 0.0;
+        for (boost::tie(nzi, nziend) = row_nonzeros(*ri, b); nzi != nziend; ++nzi)
+        {
+            sum += (*nzi)._val*x[(*nzi)._column];
+        }
+        z[*ri] = sum;
+    }
+    nfailed += check_vector("bcsr row_nonzeros", y, z, 1e-12);
+    return (nfailed);
+}
+
+// check a csr product against a dense product, the sorted flag checks
+// that the columns of each row are sorted and free of duplicates
+int check_spgemm(const char* name, const std::vector<double>& dense,
+    int nr, int nc, const std::vector<int>& ci, const std::vector<int>& cj,
+    const std::vector<double>& cv, bool sorted)
+{
+    std::vector<double> z(dense.size(), 0.0);
+    int nunsorted = 0;
+    for (int i=0; i < nr; ++i)
+    {
+        for (int p=ci[i]; p < ci[i+1]; ++p)
+        {
+            if (sorted && p > ci[i] && cj[p-1] >= cj[p]) { ++nunsorted; }
+            z[i*nc + cj[p]] += cv[p];
+        }
+    }
+    if (nunsorted > 0)
+    {
+        std::cout << name << ": unsorted columns FAILED" << std::endl;
+        return (1);
+    }
+    return (check_vector(name, dense, z, 1e-10));
+}
+
+int main(int argc, char **argv)
+{
+    using namespace std;
+    using namespace yasmic;
+
+    int nr = 1000, nc = 800;
+
+    vector<int> rows, cols;
+    vector<double> vals;
+    random_power_law_csr(nr, nc, rows, cols, vals);
+    int nz = (int)cols.size();
+
+    typedef compressed_row_matrix<
+        vector<int>::iterator, vector<int>::iterator, vector<double>::iterator >
+        crs_matrix;
+    typedef simple_csr_matrix<int,double> simple_csr;
+
+    crs_matrix crm(rows.begin(), rows.end(), cols.begin(), cols.end(),
+            vals.begin(), vals.end(), nr, nc, nz);
+    simple_csr csr(nr, nc, nz, &rows[0], &cols[0], &vals[0]);
+
+    vector<double> x(nc), xt(nr);
+    for (int i=0; i < nc; ++i) { x[i] = (double)(i % 13) - 6.0; }
+    for (int i=0; i < nr; ++i) { xt[i] = (double)(i % 5) - 2.0; }
+
+    vector<double> y(nr), yt(nc);
+    mult(crm, x.begin(), y.begin());
+    trans_mult(crm, xt.begin(), yt.begin());
+
+    int nfailed = 0;
+
+    {
+        vector<double> z(nr);
+        mult(csr, x.begin(), z.begin());
+        nfailed += check_vector("simple_csr mult", y, z, 0.0);
+
+        vector<double> zt(nc);
+        trans_mult(csr, xt.begin(), zt.begin());
+        nfailed += check_vector("simple_csr trans_mult", yt, zt, 1e-12);
+    }
+
+    for (int nthreads=1; nthreads <= 8; nthreads *= 2)
+    {
+        vector<double> z(nr);
+        parallel_mult(crm, x.begin(), z.begin(), nthreads);
+        nfailed += check_vector("crm parallel_mult", y, z, 0.0);
+
+        fill(z.begin(), z.end(), 0.0);
+        parallel_mult(csr, &x[0], &z[0], nthreads);
+        nfailed += check_vector("simple_csr parallel_mult", y, z, 0.0);
+    }
+
+    for (int strategy=1; strategy <= 3; ++strategy)
+    {
+        typedef parallel_trans_mult_workspace<int,double> workspace;
+        workspace w(1 << 28, 4);
+        w.strategy = (workspace::strategy_type)strategy;
+        cout << "trans_mult strategy " << strategy << endl;
+        for (int iter=0; iter < 2; ++iter)
+        {
+            vector<double> zt(nc);
+            parallel_trans_mult(csr, &xt[0], &zt[0], w);
+            nfailed += check_vector("simple_csr parallel_trans_mult", yt, zt, 1e-12);
+            fill(zt.begin(), zt.end(), 0.0);
+            parallel_trans_mult(crm, xt.begin(), zt.begin(), w);
+            nfailed += check_vector("crm parallel_trans_mult", yt, zt, 1e-12);
+        }
+    }
+
+    for (int level=simd_scalar; level <= simd_detect_level(); ++level)
+    {
+        cout << "simd level " << level << endl;
+        vector<double> z(nr);
+        simd_mult(csr, &x[0], &z[0], 1, (simd_level)level);
+        nfailed += check_vector("simd_mult double", y, z, 1e-12);
+
+        fill(z.begin(), z.end(), 0.0);
+        simd_mult(csr, &x[0], &z[0], 4, (simd_level)level);
+        nfailed += check_vector("simd_mult double 4 threads", y, z, 1e-12);
+
+        vector<float> fvals(vals.begin(), vals.end());
+        vector<float> fx(x.begin(), x.end()), fz(nr);
+        simple_csr_matrix<int,float> fcsr(nr, nc, nz, &rows[0], &cols[0], &fvals[0]);
+        simd_mult(fcsr, &fx[0], &fz[0], 1, (simd_level)level);
+        vector<double> dz(fz.begin(), fz.end());
+        nfailed += check_vector("simd_mult float", y, dz, 1e-3);
+    }
+
+    for (int lg_beta=2; lg_beta <= 10; lg_beta += 4)
+    {
+        cout << "csb lg_beta " << lg_beta << endl;
+        csb_matrix<int,double> csb;
+        build_csb_from_csr(crm, csb, lg_beta);
+        for (int nthreads=1; nthreads <= 4; nthreads *= 2)
+        {
+            vector<double> z(nr), zt(nc);
+            parallel_mult(csb, &x[0], &z[0], nthreads);
+            nfailed += check_vector("csb parallel_mult", y, z, 1e-12);
+            parallel_trans_mult(csb, &xt[0], &zt[0], nthreads);
+            nfailed += check_vector("csb parallel_trans_mult", yt, zt, 1e-12);
+        }
+        csb_matrix<int,double> csb2;
+        build_csb_from_csr(csr, csb2, lg_beta);
+        vector<double> z(nr), zt(nc);
+        mult(csb2, x.begin(), z.begin());
+        nfailed += check_vector("csb mult", y, z, 1e-12);
+        trans_mult(csb2, xt.begin(), zt.begin());
+        nfailed += check_vector("csb trans_mult", yt, zt, 1e-12);
+    }
+
+    {
+        block_csr_matrix<int,double,1,1> b11;
+        nfailed += check_bcsr("bcsr 1x1", crm, b11, x, xt, y, yt);
+        block_csr_matrix<int,double,2,3> b23;
+        nfailed += check_bcsr("bcsr 2x3", crm, b23, x, xt, y, yt);
+        block_csr_matrix<int,double,4,4> b44;
+        nfailed += check_bcsr("bcsr 4x4", crm, b44, x, xt, y, yt);
+
+        // a matrix of dense 3x3 blocks should pick 3x3 with no fill
+        int nb = nr/3;
+        vector<int> brows(1, 0), bcols;
+        vector<double> bvals;
+        for (int i=0; i < 3*nb; ++i)
+        {
+            int bc[3] = { (i/3) % nb, (i/3 + 5) % nb, (7*(i/3) + 1) % nb };
+            sort(bc, bc+3);
+            for (int k=0; k < 3; ++k)
+            {
+                if (k > 0 && bc[k] == bc[k-1]) { continue; }
+                for (int j=0; j < 3; ++j)
+                {
+                    bcols.push_back(3*bc[k]+j);
+                    bvals.push_back(1.0 + (double)((i+j+k) % 4));
+                }
+            }
+            brows.push_back((int)bcols.size());
+        }
+        crs_matrix bcrm(brows.begin(), brows.end(), bcols.begin(), bcols.end(),
+            bvals.begin(), bvals.end(), 3*nb, 3*nb, (int)bcols.size());
+        int r, c;
+        double fill = choose_bcsr_block_size(bcrm, r, c);
+        cout << "choose_bcsr_block_size " << r << "x" << c
+             << " fill " << fill << endl;
+        if (r != 3 || c != 3 || fill != 1.0)
+        {
+            cout << "choose_bcsr_block_size: FAILED" << endl;
+            ++nfailed;
+        }
+    }
+
+    for (int c=1; c <= 16; c *= 4)
+    {
+        for (int sigma=1; sigma <= nr; sigma *= 32)
+        {
+            sell_c_sigma_matrix<int,double> s;
+            double pad = build_sell_from_csr(csr, s, c, sigma);
+            cout << "sell c " << c << " sigma " << sigma
+                 << " padding " << pad << endl;
+            vector<double> z(nr);
+            mult(s, x.begin(), z.begin());
+            nfailed += check_vector("sell mult", y, z, 1e-12);
+            for (int level=simd_scalar; level <= simd_detect_level(); ++level)
+            {
+                fill(z.begin(), z.end(), 0.0);
+                simd_mult(s, &x[0], &z[0], 4, (simd_level)level);
+                nfailed += check_vector("sell simd_mult double", y, z, 1e-12);
+            }
+
+            vector<float> fvals(vals.begin(), vals.end());
+            vector<float> fx(x.begin(), x.end()), fz(nr);
+            simple_csr_matrix<int,float> fcsr(nr, nc, nz, &rows[0], &cols[0], &fvals[0]);
+            sell_c_sigma_matrix<int,float> fs;
+            build_sell_from_csr(fcsr, fs, c, sigma);
+            simd_mult(fs, &fx[0], &fz[0]);
+            vector<double> dz(fz.begin(), fz.end());
+            nfailed += check_vector("sell simd_mult float", y, dz, 1e-3);
+        }
+    }
+
+    {
+        // rows without any nonzeros, so the SELL arrays are empty
+        int erows[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        int ecol = 0;
+        double eval = 0.0;
+        simple_csr_matrix<int,double> ecsr(9, 9, 0, erows, &ecol, &eval);
+        sell_c_sigma_matrix<int,double> es;
+        build_sell_from_csr(ecsr, es, 8, 4);
+        vector<double> ex(9, 1.0), ez(9, 1.0), ezero(9, 0.0);
+        mult(es, ex.begin(), ez.begin());
+        nfailed += check_vector("sell mult empty", ezero, ez, 0.0);
+        for (int level=simd_scalar; level <= simd_detect_level(); ++level)
+        {
+            fill(ez.begin(), ez.end(), 1.0);
+            simd_mult(es, &ex[0], &ez[0], 2, (simd_level)level);
+            nfailed += check_vector("sell simd_mult empty", ezero, ez, 0.0);
+        }
+    }
+
+    {
+        typedef dcsr_matrix<int,double> dcsr;
+        dcsr d;
+        build_dcsr_from_csr(crm, d);
+        cout << "dcsr nzrows " << d.nzrows() << " of " << nrows(d) << endl;
+        if (nrows(d) != nr || ncols(d) != nc || nnz(d) != nz)
+        {
+            cout << "dcsr dimensions: FAILED" << endl;
+            ++nfailed;
+        }
+
+        vector<double> z(nr), zt(nc);
+        mult(d, x.begin(), z.begin());
+        nfailed += check_vector("dcsr mult", y, z, 1e-12);
+        trans_mult(d, xt.begin(), zt.begin());
+        nfailed += check_vector("dcsr trans_mult", yt, zt, 1e-12);
+
+        // mult through the nonzero and row iterators
+        fill(z.begin(), z.end(), 0.0);
+        smatrix_traits<dcsr>::nonzero_iterator nzi, nziend;
+        for (boost::tie(nzi, nziend) = nonzeros(d); nzi != nziend; ++nzi)
+        {
+            z[(*nzi)._row] += (*nzi)._val*x[(*nzi)._column];
+        }
+        nfailed += check_vector("dcsr nonzeros", y, z, 1e-12);
+
+        fill(z.begin(), z.end(), 0.0);
+        smatrix_traits<dcsr>::row_iterator ri, riend;
+        for (boost::tie(ri, riend) = yasmic::rows(d); ri != riend; ++ri)
+        {
+            smatrix_traits<dcsr>::row_nonzero_iterator rnzi, rnziend;
+            for (boost::tie(rnzi, rnziend) = row_nonzeros(*ri, d);
+                 rnzi != rnziend; ++rnzi)
+            {
+                z[*ri] += (*rnzi)._val*x[(*rnzi)._column];
+            }
+        }
+        nfailed += check_vector("dcsr row_nonzeros", y, z, 1e-12);
+
+        vector<int> drows(nr+1), dcols(nz);
+        vector<double> dvals(nz);
+        build_csr_from_dcsr(d, drows.begin(), dcols.begin(), dvals.begin());
+        if (drows != rows || dcols != cols || dvals != vals)
+        {
+            cout << "build_csr_from_dcsr: FAILED" << endl;
+            ++nfailed;
+        }
+    }
+
+    for (int k=1; k <= 21; k += 5)
+    {
+        cout << "spmm k " << k << endl;
+        // X(i,j) = x[i] + j, so column j of Y = A*X is y + j*(A*1)
+        vector<double> ones(nc, 1.0), rowsums(nr), colsums(nc);
+        vector<double> onest(nr, 1.0);
+        mult(csr, ones.begin(), rowsums.begin());
+        trans_mult(csr, onest.begin(), colsums.begin());
+
+        vector<double> X(nc*k), XT(nr*k);
+        for (int i=0; i < nc; ++i) {
+            for (int j=0; j < k; ++j) { X[i*k+j] = x[i] + j; }
+        }
+        for (int i=0; i < nr; ++i) {
+            for (int j=0; j < k; ++j) { XT[i*k+j] = xt[i] + j; }
+        }
+        vector<double> Y(nr*k), YT(nc*k), Z(nr*k), ZT(nc*k);
+        for (int i=0; i < nr; ++i) {
+            for (int j=0; j < k; ++j) { Y[i*k+j] = y[i] + j*rowsums[i]; }
+        }
+        for (int i=0; i < nc; ++i) {
+            for (int j=0; j < k; ++j) { YT[i*k+j] = yt[i] + j*colsums[i]; }
+        }
+
+        spmm(csr, &X[0], &Z[0], k, 1);
+        nfailed += check_vector("simple_csr spmm", Y, Z, 1e-10);
+        fill(Z.begin(), Z.end(), 0.0);
+        spmm(crm, X.begin(), Z.begin(), k, 4);
+        nfailed += check_vector("crm spmm", Y, Z, 1e-10);
+
+        for (int strategy=1; strategy <= 3; ++strategy)
+        {
+            typedef parallel_trans_mult_workspace<int,double> workspace;
+            workspace w(1 << 28, 4);
+            w.strategy = (workspace::strategy_type)strategy;
+            trans_spmm(csr, &XT[0], &ZT[0], k, w);
+            nfailed += check_vector("simple_csr trans_spmm", YT, ZT, 1e-10);
+            fill(ZT.begin(), ZT.end(), 0.0);
+            trans_spmm(crm, XT.begin(), ZT.begin(), k, w);
+            nfailed += check_vector("crm trans_spmm", YT, ZT, 1e-10);
+        }
+    }
+
+    {
+        // B is ncols x 300 with a few dense rows
+        int bnc = 300;
+        vector<int> brows, bcols;
+        vector<double> bvals;
+        random_power_law_csr(nc, bnc, brows, bcols, bvals);
+        simple_csr b(nc, bnc, (int)bcols.size(), &brows[0], &bcols[0], &bvals[0]);
+        crs_matrix bcrm(brows.begin(), brows.end(), bcols.begin(), bcols.end(),
+            bvals.begin(), bvals.end(), nc, bnc, (int)bcols.size());
+
+        // the mask keeps every third column in the even rows, and every
+        // 61st in the odd rows, so both accumulators are used
+        vector<int> mrows(nr+1, 0), mcols;
+        vector<double> mvals;
+        for (int i=0; i < nr; ++i)
+        {
+            int step = i % 2 ? 61 : 3;
+            for (int j=i % 3; j < bnc; j += step) { mcols.push_back(j); mvals.push_back(1.0); }
+            mrows[i+1] = (int)mcols.size();
+        }
+        simple_csr mask(nr, bnc, (int)mcols.size(), &mrows[0], &mcols[0], &mvals[0]);
+        crs_matrix mcrm(mrows.begin(), mrows.end(), mcols.begin(), mcols.end(),
+            mvals.begin(), mvals.end(), nr, bnc, (int)mcols.size());
+
+        vector<double> dense(nr*bnc, 0.0), dmasked(nr*bnc, 0.0);
+        for (int i=0; i < nr; ++i) {
+            for (int p=rows[i]; p < rows[i+1]; ++p) {
+                for (int q=brows[cols[p]]; q < brows[cols[p]+1]; ++q) {
+                    dense[i*bnc + bcols[q]] += vals[p]*bvals[q];
+                }
+            }
+        }
+        for (int i=0; i < nr; ++i) {
+            int step = i % 2 ? 61 : 3;
+            for (int j=i % 3; j < bnc; j += step) { dmasked[i*bnc+j] = dense[i*bnc+j]; }
+        }
+
+        for (int nthreads=1; nthreads <= 4; nthreads *= 4)
+        {
+            vector<int> ci, cj;
+            vector<double> cv;
+            spgemm(csr, b, ci, cj, cv, true, nthreads);
+            nfailed += check_spgemm("simple_csr spgemm", dense, nr, bnc, ci, cj, cv, true);
+            spgemm(crm, bcrm, ci, cj, cv, false, nthreads);
+            nfailed += check_spgemm("crm spgemm unsorted", dense, nr, bnc, ci, cj, cv, false);
+            spgemm(csr, b, mask, ci, cj, cv, true, nthreads);
+            nfailed += check_spgemm("simple_csr masked spgemm", dmasked, nr, bnc, ci, cj, cv, true);
+            spgemm(crm, bcrm, mcrm, ci, cj, cv, true, nthreads);
+            nfailed += check_spgemm("crm masked spgemm", dmasked, nr, bnc, ci, cj, cv, true);
+        }
+    }
+
+    {
+        // semiring products against direct loops
+        vector<double> z(nr), zmin(nr), zmax(nr);
+        for (int i=0; i < nr; ++i)
+        {
+            zmin[i] = min_plus_semiring<double>::zero();
+            zmax[i] = max_min_semiring<double>::zero();
+            for (int p=rows[i]; p < rows[i+1]; ++p)
+            {
+                zmin[i] = min(zmin[i], vals[p] + x[cols[p]]);
+                zmax[i] = max(zmax[i], min(vals[p], x[cols[p]]));
+            }
+        }
+        semiring_mult< plus_times_semiring<double> >(csr, x.begin(), z.begin());
+        nfailed += check_vector("plus_times semiring_mult", y, z, 1e-12);
+        semiring_mult< min_plus_semiring<double> >(crm, x.begin(), z.begin(), 4);
+        nfailed += check_vector("min_plus semiring_mult", zmin, z, 0.0);
+        semiring_mult< max_min_semiring<double> >(csr, &x[0], &z[0], 1);
+        nfailed += check_vector("max_min semiring_mult", zmax, z, 0.0);
+
+        // the masked version leaves the other entries alone
+        vector<char> odd(nr);
+        for (int i=0; i < nr; ++i) { odd[i] = (char)(i % 2); }
+        vector<double> zm(nr, -1.0), ym(nr);
+        for (int i=0; i < nr; ++i) { ym[i] = i % 2 ? -1.0 : zmin[i]; }
+        semiring_mult< min_plus_semiring<double> >(csr, x.begin(), zm.begin(),
+            odd.begin(), true, 4);
+        nfailed += check_vector("min_plus masked semiring_mult", ym, zm, 0.0);
+    }
+
+    {
+        // breadth first search over (or, and) with a complemented mask
+        vector<int> grows, gcols;
+        vector<double> gvals;
+        random_power_law_csr(nr, nr, grows, gcols, gvals);
+        int gnz = (int)gcols.size();
+        vector<int> ati(nr+1), atj(gnz), atid(gnz);
+        simple_csr g(nr, nr, gnz, &grows[0], &gcols[0], &gvals[0]);
+        build_row_and_column_from_csr(g, &ati[0], &atj[0], &atid[0]);
+        simple_row_and_column_matrix<int,double> grc(nr, nr, gnz,
+            &grows[0], &gcols[0], &gvals[0], &ati[0], &atj[0], &atid[0]);
+        crs_matrix gcrm(grows.begin(), grows.end(), gcols.begin(), gcols.end(),
+            gvals.begin(), gvals.end(), nr, nr, gnz);
+
+        vector<int> level(nr, -1), queue(1, 0);
+        level[0] = 0;
+        for (size_t q=0; q < queue.size(); ++q)
+        {
+            int i = queue[q];
+            for (int p=grows[i]; p < grows[i+1]; ++p)
+            {
+                if (level[gcols[p]] < 0)
+                {
+                    level[gcols[p]] = level[i]+1;
+                    queue.push_back(gcols[p]);
+                }
+            }
+        }
+
+        typedef spmspv_workspace<int,bool> workspace;
+        for (int dir=0; dir < 4; ++dir)
+        {
+            workspace w((workspace::direction_type)(dir % 3));
+            vector<char> visited(nr, 0);
+            vector<int> slevel(nr, -1);
+            sparse_vector<int,bool> frontier, next;
+            frontier.push_back(0, true);
+            visited[0] = 1;
+            slevel[0] = 0;
+            int npull = 0;
+            for (int d=1; frontier.size() > 0; ++d)
+            {
+                if (dir < 3)
+                {
+                    semiring_spmspv<or_and_semiring>(grc, frontier, next, w,
+                        visited.begin(), true);
+                }
+                else
+                {
+                    semiring_spmspv<or_and_semiring>(gcrm, frontier, next, w,
+                        visited.begin(), true);
+                }
+                npull += w.last_direction == workspace::pull_direction;
+                for (size_t k=0; k < next.size(); ++k)
+                {
+                    visited[next.ind[k]] = 1;
+                    slevel[next.ind[k]] = d;
+                }
+                swap(frontier, next);
+            }
+            cout << "bfs direction " << dir << " pull steps " << npull << endl;
+            if (slevel != level)
+            {
+                cout << "semiring_spmspv bfs: FAILED" << endl;
+                ++nfailed;
+            }
+        }
+    }
+
+    {
+        // fused kernels against mult followed by the vector operations
+        vector<double> y0(nr), w(nr), ref(nr);
+        double nrm2 = 0.0, nrm1 = 0.0, dot = 0.0;
+        for (int i=0; i < nr; ++i)
+        {
+            y0[i] = (double)(i % 3) - 1.0;
+            w[i] = (double)(i % 7);
+            ref[i] = 2.0*y[i] - 0.5*y0[i];
+            nrm2 += ref[i]*ref[i];
+            nrm1 += fabs(ref[i]);
+            dot += ref[i]*w[i];
+        }
+        nrm2 = sqrt(nrm2);
+
+        for (int nthreads=1; nthreads <= 4; nthreads *= 4)
+        {
+            vector<double> z(y0);
+            double r = mult_axpby_nrm2(csr, 2.0, x.begin(), -0.5, z.begin(), nthreads);
+            nfailed += check_vector("mult_axpby_nrm2", ref, z, 1e-12);
+            nfailed += check_vector("mult_axpby_nrm2 norm", vector<double>(1, nrm2),
+                vector<double>(1, r), 1e-10);
+            z = y0;
+            r = mult_axpby_nrm1(crm, 2.0, x.begin(), -0.5, z.begin(), nthreads);
+            nfailed += check_vector("mult_axpby_nrm1 norm", vector<double>(1, nrm1),
+                vector<double>(1, r), 1e-10);
+            z = y0;
+            r = mult_axpby_dot(crm, 2.0, &x[0], -0.5, &z[0], w.begin(), nthreads);
+            nfailed += check_vector("mult_axpby_dot", vector<double>(1, dot),
+                vector<double>(1, r), 1e-10);
+        }
+
+        // beta = 0 must not read y
+        vector<double> z(nr, 0.0/0.0), ax(y);
+        mult_axpby_nrm2(csr, 1.0, x.begin(), 0.0, z.begin());
+        nfailed += check_vector("mult_axpby beta=0", ax, z, 0.0);
+
+        vector<double> ata(nc), zt(nc);
+        trans_mult(crm, y.begin(), ata.begin());
+        for (int nthreads=1; nthreads <= 4; nthreads *= 4)
+        {
+            parallel_trans_mult_workspace<int,double> ws(1 << 28, nthreads);
+            normal_mult(csr, x.begin(), zt.begin(), ws);
+            nfailed += check_vector("simple_csr normal_mult", ata, zt, 1e-10);
+            fill(zt.begin(), zt.end(), 0.0);
+            normal_mult(crm, &x[0], &zt[0], ws);
+            nfailed += check_vector("crm normal_mult", ata, zt, 1e-10);
+        }
+    }
+
+    {
+        // pagerank of a small graph with a dangling page (5), a self loop
+        // (1 -> 1) and a weighted link (0 -> 2) against a dense power method
+        const int n = 6;
+        int pri[] = {0, 1, 3, 6, 7, 8, 9};
+        int prj[] = {2, 0, 1, 0, 1, 3, 4, 3, 4};
+        double prv[] = {1.0, 1.0, 1.0, 2.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+        simple_csr_matrix<int,double> g(n, n, 9, pri, prj, prv);
+
+        double alpha = 0.85;
+        vector<double> outd(n, 0.0), v(n), ref(n, 1.0/n), next(n);
+        for (int k=0; k < 9; ++k) { outd[prj[k]] += prv[k]; }
+        for (int i=0; i < n; ++i) { v[i] = (double)(i+1)/21.0; }
+        for (int iter=0; iter < 2000; ++iter)
+        {
+            double dangling = 0.0;
+            for (int j=0; j < n; ++j) { if (outd[j] == 0.0) { dangling += ref[j]; } }
+            for (int i=0; i < n; ++i)
+            {
+                next[i] = (alpha*dangling + 1.0 - alpha)*v[i];
+                for (int k=pri[i]; k < pri[i+1]; ++k)
+                {
+                    next[i] += alpha*prv[k]/outd[prj[k]]*ref[prj[k]];
+                }
+            }
+            ref.swap(next);
+        }
+
+        pagerank_options opts;
+        opts.alpha = alpha;
+        opts.tol = 1e-13;
+        vector<double> pr(n), resids;
+        vector<double> times;
+        for (int nthreads=1; nthreads <= 4; nthreads *= 4)
+        {
+            opts.nthreads = nthreads;
+            opts.method = pagerank_options::power_method;
+            opts.extrapolate_every = 0;
+            pagerank(g, pr.begin(), v.begin(), opts, pagerank_no_callback());
+            nfailed += check_vector("pagerank power", ref, pr, 1e-11);
+
+            for (opts.extrapolate_every = 6; opts.extrapolate_every <= 8;
+                 opts.extrapolate_every += 2)
+            {
+                pagerank(g, pr.begin(), v.begin(), opts, pagerank_no_callback());
+                nfailed += check_vector("pagerank extrapolation", ref, pr, 1e-11);
+            }
+        }
+        opts.extrapolate_every = 0;
+        opts.method = pagerank_options::gauss_seidel;
+        int gsiter = pagerank(g, &pr[0], &v[0], opts,
+            pagerank_history_callback<double>(resids, times));
+        nfailed += check_vector("pagerank gauss-seidel", ref, pr, 1e-11);
+        if (resids.size() != (size_t)gsiter || resids.back() >= opts.tol)
+        {
+            cout << "pagerank history: bad residuals" << endl;
+            nfailed++;
+        }
+
+        // the uniform vector with a compressed_row_matrix
+        compressed_row_matrix<int*, int*, double*> gc(pri, pri + n + 1, prj, prj + 9,
+            prv, prv + 9, n, n, 9);
+        vector<double> pru(n), prc(n);
+        opts.method = pagerank_options::power_method;
+        for (int i=0; i < n; ++i) { v[i] = 1.0/n; }
+        pagerank(g, pru.begin(), v.begin(), opts, pagerank_no_callback());
+        pagerank(gc, prc.begin(), opts);
+        nfailed += check_vector("crm pagerank uniform", pru, prc, 1e-11);
+    }
+
+    {
+        // push personalized pagerank on two triangles joined by an edge,
+        // against a dense power method
+        const int n = 6;
+        int gi[] = {0, 2, 4, 7, 10, 12, 14};
+        int gj[] = {1, 2, 0, 2, 0, 1, 3, 2, 4, 5, 3, 5, 3, 4};
+        double gv[14];
+        fill(gv, gv + 14, 1.0);
+        simple_csr_matrix<int,double> g(n, n, 14, gi, gj, gv);
+
+        double alpha = 0.85, eps = 1e-10;
+        vector<double> ref(n, 0.0), next(n);
+        for (int iter=0; iter < 500; ++iter)
+        {
+            for (int i=0; i < n; ++i) { next[i] = i == 1 ? 1.0 - alpha : 0.0; }
+            for (int u=0; u < n; ++u)
+            {
+                for (int k=gi[u]; k < gi[u+1]; ++k)
+                {
+                    next[gj[k]] += alpha*ref[u]/(gi[u+1] - gi[u]);
+                }
+            }
+            ref.swap(next);
+        }
+
+        sparse_vector<int,double> y;
+        ppr_push_workspace<int,double> w;
+        ppr_push(g, 1, alpha, eps, y, w);
+        vector<double> pr(n, 0.0);
+        for (size_t i=0; i < y.size(); ++i) { pr[y.ind[i]] = y.val[i]; }
+        nfailed += check_vector("ppr_push", ref, pr, 1e-8);
+        for (size_t i=0; i < w.r.size(); ++i)
+        {
+            int u = w.r.key(i);
+            if (w.r.value(i) >= eps*(gi[u+1] - gi[u]))
+            {
+                cout << "ppr_push: residual above tolerance" << endl;
+                nfailed++;
+                break;
+            }
+        }
+
+        // sparse_map keeps working across a partial clear
+        sparse_map<int,double> sm;
+        for (int k=0; k < 3; ++k)
+        {
+            for (int i=0; i < 5 + 200*k; ++i) { sm[i*64] += i; }
+            for (int i=0; i < 5 + 200*k; ++i)
+            {
+                if (sm.get(i*64) != i || sm.contains(i*64 + 1))
+                {
+                    cout << "sparse_map: wrong value" << endl;
+                    nfailed++;
+                }
+            }
+            sm.clear();
+            if (sm.contains(0) || sm.contains(64) || sm.size() != 0)
+            {
+                cout << "sparse_map: clear failed" << endl;
+                nfailed++;
+            }
+        }
+
+        // the sweep over the ppr vector finds the seed's triangle, with
+        // one cut edge and volume 7 of 14
+        sweep_cut_result<int> sc;
+        sweep_cut_workspace sw;
+        sweep_cut(g, y, sc, sw);
+        vector<int> best(sc.order.begin(), sc.order.begin() + sc.best_size);
+        sort(best.begin(), best.end());
+        if (sc.order.size() != (size_t)n || best.size() != 3 || best[0] != 0
+            || best[2] != 2 || sc.cut[2] != 1 || sc.volume[2] != 7)
+        {
+            cout << "sweep_cut: wrong best set" << endl;
+            nfailed++;
+        }
+        nfailed += check_vector("sweep_cut conductance",
+            vector<double>(1, 1.0/7.0), vector<double>(1, sc.best_conductance), 1e-15);
+        for (int u=0; u < n; ++u)
+        {
+            if (sw.member[u]) { cout << "sweep_cut: bitmap not reset" << endl; nfailed++; }
+        }
+
+        // hk_relax against the dense series exp(-t) sum t^k/k! P^k e_1
+        double t = 3.0, hkeps = 1e-6;
+        vector<double> term(n, 0.0), hk(n, 0.0);
+        term[1] = exp(-t);
+        for (int k=0; k < 60; ++k)
+        {
+            for (int i=0; i < n; ++i) { hk[i] += term[i]; }
+            fill(next.begin(), next.end(), 0.0);
+            for (int u=0; u < n; ++u)
+            {
+                for (int e=gi[u]; e < gi[u+1]; ++e)
+                {
+                    next[gj[e]] += t/(k+1)*term[u]/(gi[u+1] - gi[u]);
+                }
+            }
+            term.swap(next);
+        }
+        hk_relax_workspace<int,double> hw;
+        sparse_vector<int,double> h;
+        hk_relax(g, 1, t, hkeps, h, hw);
+        vector<double> hx(n, 0.0);
+        for (size_t i=0; i < h.size(); ++i) { hx[h.ind[i]] = h.val[i]; }
+        for (int u=0; u < n; ++u)
+        {
+            if (fabs(hk[u] - hx[u]) >= hkeps*(gi[u+1] - gi[u]))
+            {
+                cout << "hk_relax: error above tolerance at " << u << endl;
+                nfailed++;
+            }
+        }
+        sweep_cut(g, h, sc, sw);
+        nfailed += check_vector("hk_relax sweep_cut conductance",
+            vector<double>(1, 1.0/7.0), vector<double>(1, sc.best_conductance), 1e-15);
+
+        // the batch gives the same vectors as one seed at a time
+        int seeds[] = {0, 1, 2, 3, 4, 5, 1};
+        vector< sparse_vector<int,double> > hs;
+        hk_relax_batch(g, seeds, seeds + 7, t, 1e-3, hs, 4);
+        for (int s=0; s < 7; ++s)
+        {
+            hk_relax(g, seeds[s], t, 1e-3, h, hw);
+            nfailed += check_vector("hk_relax_batch", h.val, hs[s].val, 0.0);
+        }
+        vector< sparse_vector<int,double> > ys;
+        ppr_push_batch(g, seeds, seeds + 7, alpha, 1e-4, ys, 4);
+        for (int s=0; s < 7; ++s)
+        {
+            ppr_push(g, seeds[s], alpha, 1e-4, y, w);
+            nfailed += check_vector("ppr_push_batch", y.val, ys[s].val, 0.0);
+        }
+    }
+
+    {
+        // parallel_core_numbers gives the same cores as core_numbers
+        vector<int> gr, gc;
+        vector<double> gv;
+        random_symmetric_graph(2000, gr, gc, gv);
+        simple_csr_matrix<int,double> g(2000, 2000, (int)gc.size(),
+            &gr[0], &gc[0], &gv[0]);
+        vector<int> cn(2000);
+        boost::core_numbers(g, boost::make_iterator_property_map(cn.begin(),
+            boost::get(boost::vertex_index, g)));
+        vector<double> ref(cn.begin(), cn.end());
+        for (int nthreads=1; nthreads <= 4; nthreads *= 2)
+        {
+            vector<int> pcn(2000);
+            int kmax = parallel_core_numbers(g, pcn.begin(), nthreads);
+            nfailed += check_vector("parallel_core_numbers",
+                ref, vector<double>(pcn.begin(), pcn.end()), 0.0);
+            if (kmax != *max_element(cn.begin(), cn.end()))
+            {
+                cout << "parallel_core_numbers: wrong max core" << endl;
+                nfailed++;
+            }
+        }
+
+        // dynamic_core_numbers after batches of deletions and insertions
+        // against cores from scratch
+        dynamic_core_numbers<int> dcore(g);
+        nfailed += check_vector("dynamic_core_numbers initial",
+            ref, vector<double>(dcore.cores().begin(), dcore.cores().end()), 0.0);
+        for (int batch=0; batch < 5; ++batch)
+        {
+            vector<int> rp, rc;
+            dcore.build_csr(rp, rc);
+            vector< pair<int,int> > dels, ins;
+            for (int k=0; k < 300; ++k)
+            {
+                int u = rand() % 2000;
+                if (rp[u] == rp[u+1]) { continue; }
+                dels.push_back(make_pair(u, rc[rp[u] + rand() % (rp[u+1] - rp[u])]));
+            }
+            for (int k=0; k < 300; ++k)
+            {
+                // favor the low numbered, high degree vertices
+                ins.push_back(make_pair(rand() % (50 + 400*batch), rand() % 2000));
+            }
+            dcore.update(dels.begin(), dels.end(), ins.begin(), ins.end());
+
+            dcore.build_csr(rp, rc);
+            vector<double> ones(rc.size(), 1.0);
+            simple_csr_matrix<int,double> h(2000, 2000, (int)rc.size(),
+                &rp[0], &rc[0], &ones[0]);
+            vector<int> hcn(2000);
+            parallel_core_numbers(h, hcn.begin());
+            nfailed += check_vector("dynamic_core_numbers batch",
+                vector<double>(hcn.begin(), hcn.end()),
+                vector<double>(dcore.cores().begin(), dcore.cores().end()), 0.0);
+            if ((int)dcore.max_core() != *max_element(hcn.begin(), hcn.end())
+                || dcore.count(1) != (size_t)count(hcn.begin(), hcn.end(), 1))
+            {
+                cout << "dynamic_core_numbers: wrong core counts" << endl;
+                nfailed++;
+            }
+        }
+
+        // weighted cores with integer weights use the bucket queue, the
+        // same weights as doubles use the mutable_queue
+        vector<int> iw(gc.size());
+        for (size_t k=0; k < gc.size(); ++k)
+        {
+            iw[k] = 1 + (gr.size() + gc[k]) % 5;
+            gv[k] = iw[k];
+        }
+        simple_csr_matrix<int,int> gi(2000, 2000, (int)gc.size(),
+            &gr[0], &gc[0], &iw[0]);
+        vector<int> icn(2000);
+        vector<double> dcn(2000);
+        int imax = boost::weighted_core_numbers(gi, boost::make_iterator_property_map(
+            icn.begin(), boost::get(boost::vertex_index, gi)));
+        double dmax = boost::weighted_core_numbers(g, boost::make_iterator_property_map(
+            dcn.begin(), boost::get(boost::vertex_index, g)));
+        nfailed += check_vector("weighted core_numbers buckets",
+            dcn, vector<double>(icn.begin(), icn.end()), 0.0);
+        if (imax != (int)dmax)
+        {
+            cout << "weighted core_numbers: wrong last core" << endl;
+            nfailed++;
+        }
+    }
+
+    {
+        // truss_numbers against peeling the k-trusses one at a time, on
+        // a sparse graph with a dense block
+        int n = 300;
+        vector<char> adj(n*n, 0);
+        for (int k=0; k < 900; ++k)
+        {
+            int i = rand() % n, j = rand() % n;
+            if (i != j) { adj[i*n+j] = adj[j*n+i] = 1; }
+        }
+        for (int i=0; i < 40; ++i)
+        {
+            for (int j=0; j < i; ++j)
+            {
+                if (rand() % 2) { adj[i*n+j] = adj[j*n+i] = 1; }
+            }
+        }
+        vector<int> gr(n+1, 0), gc;
+        for (int i=0; i < n; ++i)
+        {
+            for (int j=0; j < n; ++j) { if (adj[i*n+j]) { gc.push_back(j); } }
+            gr[i+1] = (int)gc.size();
+        }
+        vector<double> gv(gc.size(), 1.0);
+        simple_csr_matrix<int,double> g(n, n, (int)gc.size(),
+            &gr[0], &gc[0], &gv[0]);
+
+        vector<double> ref(gc.size(), 2.0);
+        vector<char> alive(adj);
+        for (int k=3; ; ++k)
+        {
+            bool changed = true;
+            while (changed)
+            {
+                changed = false;
+                for (int i=0; i < n; ++i)
+                {
+                    for (int j=i+1; j < n; ++j)
+                    {
+                        if (!alive[i*n+j]) { continue; }
+                        int s = 0;
+                        for (int w=0; w < n; ++w)
+                        {
+                            s += alive[i*n+w] && alive[j*n+w];
+                        }
+                        if (s < k-2)
+                        {
+                            alive[i*n+j] = alive[j*n+i] = 0;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+            int nalive = 0;
+            for (int i=0; i < n; ++i)
+            {
+                for (int p=gr[i]; p < gr[i+1]; ++p)
+                {
+                    if (alive[i*n+gc[p]]) { ref[p] = k; ++nalive; }
+                }
+            }
+            if (nalive == 0) { break; }
+        }
+
+        for (int nthreads=1; nthreads <= 4; nthreads *= 2)
+        {
+            vector<int> truss(gc.size());
+            int kmax = truss_numbers(g, truss.begin(), nthreads);
+            nfailed += check_vector("truss_numbers",
+                ref, vector<double>(truss.begin(), truss.end()), 0.0);
+            if (kmax != (int)*max_element(ref.begin(), ref.end()))
+            {
+                cout << "truss_numbers: wrong max truss" << endl;
+                nfailed++;
+            }
+        }
+    }
+
+    {
+        // triangle_counts and clustering coefficients against a brute
+        // force count, on a sparse graph with a dense block
+        int n = 300;
+        vector<char> adj(n*n, 0);
+        for (int k=0; k < 1200; ++k)
+        {
+            int i = rand() % n, j = rand() % n;
+            if (i != j) { adj[i*n+j] = adj[j*n+i] = 1; }
+        }
+        for (int i=0; i < 60; ++i)
+        {
+            for (int j=0; j < i; ++j)
+            {
+                if (rand() % 3 == 0) { adj[i*n+j] = adj[j*n+i] = 1; }
+            }
+        }
+        vector<int> gr(n+1, 0), gc;
+        for (int i=0; i < n; ++i)
+        {
+            for (int j=0; j < n; ++j) { if (adj[i*n+j]) { gc.push_back(j); } }
+            gr[i+1] = (int)gc.size();
+        }
+        vector<double> gv(gc.size(), 1.0);
+        simple_csr_matrix<int,double> g(n, n, (int)gc.size(),
+            &gr[0], &gc[0], &gv[0]);
+
+        vector<double> reftri(n, 0.0), refcc(n, 0.0);
+        size_t refntri = 0;
+        for (int i=0; i < n; ++i)
+        {
+            for (int j=i+1; j < n; ++j)
+            {
+                if (!adj[i*n+j]) { continue; }
+                for (int k=j+1; k < n; ++k)
+                {
+                    if (adj[i*n+k] && adj[j*n+k])
+                    {
+                        reftri[i] += 1; reftri[j] += 1; reftri[k] += 1;
+                        ++refntri;
+                    }
+                }
+            }
+        }
+        for (int i=0; i < n; ++i)
+        {
+            int d = gr[i+1] - gr[i];
+            if (d > 1) { refcc[i] = 2.0*reftri[i]/((double)d*(d-1)); }
+        }
+
+        for (int nthreads=1; nthreads <= 4; nthreads *= 2)
+        {
+            for (int level=simd_scalar; level <= simd_avx512; ++level)
+            {
+                vector<int> tri(n);
+                size_t ntri = triangle_counts(g, tri.begin(), nthreads,
+                    (simd_level)level);
+                nfailed += check_vector("triangle_counts",
+                    reftri, vector<double>(tri.begin(), tri.end()), 0.0);
+                if (ntri != refntri)
+                {
+                    cout << "triangle_counts: wrong total" << endl;
+                    nfailed++;
+                }
+            }
+            vector<double> cc(n);
+            local_clustering_coefficients(g, cc.begin(), nthreads);
+            nfailed += check_vector("local_clustering_coefficients",
+                refcc, cc, 1e-14);
+        }
+
+        vector<double> bcc(n);
+        size_t nvis = 0;
+        size_t bntri = boost::clustering_coefficients(g,
+            boost::make_iterator_property_map(bcc.begin(),
+                boost::get(boost::vertex_index, g)),
+            boost::default_clustering_coefficients_visitor()
+                .do_on_triangle(triangle_counter(&nvis)));
+        nfailed += check_vector("clustering_coefficients", refcc, bcc, 1e-14);
+        if (bntri != refntri || nvis != refntri)
+        {
+            cout << "clustering_coefficients: wrong triangles" << endl;
+            nfailed++;
+        }
+    }
+
+    {
+        // parallel_betweenness_centrality against the serial Brandes
+        // algorithm, with unit and random edge lengths
+        vector<int> gr, gc;
+        vector<double> gv;
+        random_symmetric_graph(500, gr, gc, gv);
+        for (size_t k=0; k < gv.size(); ++k) { gv[k] = (double)(1 + rand() % 3); }
+        simple_csr_matrix<int,double> g(500, 500, (int)gc.size(),
+            &gr[0], &gc[0], &gv[0]);
+
+        vector<double> ref(500), wref(500);
+        boost::brandes_betweenness_centrality(g,
+            boost::make_iterator_property_map(ref.begin(),
+                boost::get(boost::vertex_index, g)));
+        boost::brandes_betweenness_centrality_dispatch2(g,
+            boost::make_iterator_property_map(wref.begin(),
+                boost::get(boost::vertex_index, g)),
+            boost::dummy_property_map(), boost::get(boost::edge_weight, g),
+            boost::get(boost::vertex_index, g));
+        for (int nthreads=1; nthreads <= 4; nthreads *= 2)
+        {
+            vector<double> bc(500), wbc(500);
+            parallel_betweenness_centrality(g, bc.begin(), nthreads);
+            parallel_weighted_betweenness_centrality(g, wbc.begin(), nthreads);
+            nfailed += check_vector("parallel_betweenness_centrality",
+                ref, bc, 1e-8);
+            nfailed += check_vector("parallel_weighted_betweenness_centrality",
+                wref, wbc, 1e-8);
+        }
+    }
+
+    {
+        // approximate_betweenness_centrality is within its bound of the
+        // exact centrality
+        int n = 3000;
+        vector<int> gr, gc;
+        vector<double> gv;
+        random_symmetric_graph(n, gr, gc, gv);
+        simple_csr_matrix<int,double> g(n, n, (int)gc.size(),
+            &gr[0], &gc[0], &gv[0]);
+        vector<double> ref(n);
+        parallel_betweenness_centrality(g, ref.begin(), 4);
+
+        for (int adaptive=0; adaptive < 2; ++adaptive)
+        {
+            betweenness_sampling_options opts;
+            opts.epsilon = 0.05;
+            opts.delta = 0.1;
+            opts.adaptive = adaptive != 0;
+            opts.nthreads = 4;
+            vector<double> bc(n);
+            betweenness_sampling_result res =
+                approximate_betweenness_centrality(g, bc.begin(), opts);
+            double err = 0.0;
+            for (int v=0; v < n; ++v)
+            {
+                err = max(err, fabs(bc[v] - ref[v])/((double)n*(n-2)));
+            }
+            cout << "approximate_betweenness_centrality: adaptive " << adaptive
+                 << " samples " << res.samples << " bound " << res.bound
+                 << " error " << err << endl;
+            if (res.bound > opts.epsilon || err > res.bound)
+            {
+                cout << "approximate_betweenness_centrality: bound failed" << endl;
+                nfailed++;
+            }
+
+            opts.max_samples = 50;
+            res = approximate_betweenness_centrality(g, bc.begin(), opts);
+            if (res.samples != 50)
+            {
+                cout << "approximate_betweenness_centrality: max_samples" << endl;
+                nfailed++;
+            }
+        }
+
+        // a sample larger than n is the exact centrality
+        betweenness_sampling_options opts;
+        opts.epsilon = 0.001;
+        vector<double> bc(n);
+        betweenness_sampling_result res =
+            approximate_betweenness_centrality(g, bc.begin(), opts);
+        nfailed += check_vector("approximate_betweenness_centrality exact",
+            ref, bc, 1e-8);
+        if (res.samples != (size_t)n || res.bound != 0.0)
+        {
+            cout << "approximate_betweenness_centrality: not exact" << endl;
+            nfailed++;
+        }
+    }
+
+    {
+        // blocked_floyd_warshall against the triple loop, with double
+        // and int lengths
+        int n = 300;
+        vector<int> gr, gc;
+        vector<double> gv;
+        random_symmetric_graph(n, gr, gc, gv);
+        for (size_t k=0; k < gv.size(); ++k) { gv[k] = (double)(1 + rand() % 5); }
+        vector<int> giv(gv.begin(), gv.end());
+        simple_csr_matrix<int,double> g(n, n, (int)gc.size(),
+            &gr[0], &gc[0], &gv[0]);
+
+        double inf = numeric_limits<double>::max();
+        vector< vector<double> > D(n, vector<double>(n));
+        vector< vector<int> > P(n, vector<int>(n));
+        boost::floyd_warshall_all_pairs_shortest_paths(g, D, P,
+            boost::get(boost::edge_weight, g), std::less<double>(),
+            boost::closed_plus<double>(), inf, 0.0);
+        vector<double> ref;
+        for (int i=0; i < n; ++i) { ref.insert(ref.end(), D[i].begin(), D[i].end()); }
+
+        vector<double> d(n*n);
+        vector<int> p(n*n);
+        for (int nthreads=1; nthreads <= 4; nthreads *= 3)
+        {
+            blocked_floyd_warshall_all_pairs_shortest_paths(g, &d[0], &p[0], nthreads);
+            nfailed += check_vector("blocked_floyd_warshall pred", ref, d, 0.0);
+
+            // each predecessor is the last step of a shortest path
+            int nbad = 0;
+            for (int i=0; i < n; ++i)
+            {
+                for (int j=0; j < n; ++j)
+                {
+                    if (i == j || d[i*n+j] == inf) { continue; }
+                    int k = p[i*n+j];
+                    int e = (int)(lower_bound(&gc[gr[k]], &gc[0] + gr[k+1], j) - &gc[0]);
+                    if (e == gr[k+1] || gc[e] != j || d[i*n+k] + gv[e] != d[i*n+j]) { nbad++; }
+                }
+            }
+            if (nbad > 0)
+            {
+                cout << "blocked_floyd_warshall: " << nbad << " bad predecessors" << endl;
+                nfailed++;
+            }
+
+            for (int level=simd_scalar; level <= simd_avx2; ++level)
+            {
+                // a block size that leaves a partial tile
+                vector<int> di(n*n);
+                int iinf = numeric_limits<int>::max();
+                for (int i=0; i < n; ++i)
+                {
+                    for (int j=0; j < n; ++j)
+                    {
+                        d[i*n+j] = i == j ? 0.0 : inf;
+                        di[i*n+j] = i == j ? 0 : iinf;
+                    }
+                    for (int k=gr[i]; k < gr[i+1]; ++k)
+                    {
+                        d[i*n+gc[k]] = gv[k];
+                        di[i*n+gc[k]] = giv[k];
+                    }
+                }
+                blocked_floyd_warshall(n, &d[0], (int*)0, nthreads, 24, (simd_level)level);
+                nfailed += check_vector("blocked_floyd_warshall", ref, d, 0.0);
+
+                blocked_floyd_warshall(n, &di[0], (int*)0, nthreads, 24, (simd_level)level);
+                vector<double> refi(ref);
+                for (int i=0; i < n*n; ++i)
+                {
+                    if (di[i] == iinf) { di[i] = -1; }
+                    if (refi[i] == inf) { refi[i] = -1; }
+                }
+                nfailed += check_vector("blocked_floyd_warshall int", refi,
+                    vector<double>(di.begin(), di.end()), 0.0);
+            }
+        }
+
+        // a negative cycle
+        vector<double> dn(4, 0.0);
+        dn[1] = 1.0; dn[2] = -2.0;
+        if (blocked_floyd_warshall(2, &dn[0], (int*)0))
+        {
+            cout << "blocked_floyd_warshall: missed a negative cycle" << endl;
+            nfailed++;
+        }
+    }
+
+    {
+        // johnson_all_pairs_shortest_paths against blocked_floyd_warshall
+        // on a directed graph with negative lengths from a potential,
+        // every cycle is still positive
+        int n = 200;
+        vector<int> gr(n+1, 0), gc;
+        vector<double> gv, pot(n);
+        for (int i=0; i < n; ++i) { pot[i] = (double)(rand() % 11); }
+        for (int i=0; i < n; ++i)
+        {
+            vector<int> row;
+            for (int k=0; k < 4; ++k)
+            {
+                int j = rand() % n;
+                if (j != i) { row.push_back(j); }
+            }
+            sort(row.begin(), row.end());
+            row.erase(unique(row.begin(), row.end()), row.end());
+            for (size_t k=0; k < row.size(); ++k)
+            {
+                gc.push_back(row[k]);
+                gv.push_back((double)(1 + rand() % 5) + pot[i] - pot[row[k]]);
+            }
+            gr[i+1] = (int)gc.size();
+        }
+        simple_csr_matrix<int,double> g(n, n, (int)gc.size(),
+            &gr[0], &gc[0], &gv[0]);
+
+        double inf = numeric_limits<double>::max();
+        vector<double> ref(n*n);
+        for (int i=0; i < n; ++i)
+        {
+            for (int j=0; j < n; ++j) { ref[i*n+j] = i == j ? 0.0 : inf; }
+            for (int k=gr[i]; k < gr[i+1]; ++k) { ref[i*n+gc[k]] = gv[k]; }
+        }
+        blocked_floyd_warshall(n, &ref[0], (int*)0);
+
+        vector< vector<double> > D(n, vector<double>(n));
+        if (!boost::johnson_all_pairs_shortest_paths(g, D,
+                boost::get(boost::vertex_index, g),
+                boost::get(boost::edge_weight, g), 0.0))
+        {
+            cout << "johnson_all_pairs_shortest_paths: false negative cycle" << endl;
+            nfailed++;
+        }
+        vector<double> d;
+        for (int i=0; i < n; ++i) { d.insert(d.end(), D[i].begin(), D[i].end()); }
+        nfailed += check_vector("johnson_all_pairs_shortest_paths", ref, d, 1e-12);
+
+        // a negative cycle
+        int cr[] = {0, 1, 2, 3};
+        int cc[] = {1, 2, 0};
+        double cv[] = {1.0, 1.0, -3.0};
+        simple_csr_matrix<int,double> gn(3, 3, 3, cr, cc, cv);
+        vector< vector<double> > Dn(3, vector<double>(3));
+        if (boost::johnson_all_pairs_shortest_paths(gn, Dn,
+                boost::get(boost::vertex_index, gn),
+                boost::get(boost::edge_weight, gn), 0.0))
+        {
+            cout << "johnson_all_pairs_shortest_paths: missed a negative cycle" << endl;
+            nfailed++;
+        }
+    }
+
+    {
+        // delta_stepping_shortest_paths against Dijkstra, with double
+        // and int weights that include zeros, and a few vertices that
+        // cannot be reached
+        int n = 2000;
+        vector<int> gr(n+1, 0), gc;
+        vector<double> gv;
+        for (int i=0; i < n; ++i)
+        {
+            vector<int> row;
+            for (int k=0; k < 6; ++k)
+            {
+                int j = rand() % (n-10);
+                if (j != i) { row.push_back(j); }
+            }
+            sort(row.begin(), row.end());
+            row.erase(unique(row.begin(), row.end()), row.end());
+            for (size_t k=0; k < row.size(); ++k)
+            {
+                gc.push_back(row[k]);
+                gv.push_back(rand() % 8 == 0 ? 0.0 : 10.0*(double)rand()/(double)RAND_MAX);
+            }
+            gr[i+1] = (int)gc.size();
+        }
+        vector<int> giv(gv.size());
+        for (size_t k=0; k < gv.size(); ++k) { giv[k] = (int)(2.0*gv[k]); }
+        simple_csr_matrix<int,double> g(n, n, (int)gc.size(),
+            &gr[0], &gc[0], &gv[0]);
+        simple_csr_matrix<int,int> gi(n, n, (int)gc.size(),
+            &gr[0], &gc[0], &giv[0]);
+
+        int srcs[] = {0, 17, n-1};
+        for (int si=0; si < 3; ++si)
+        {
+            int s = srcs[si];
+            betweenness_workspace<int,double> w;
+            betweenness_dependencies(g, s, true, w);
+            betweenness_workspace<int,int> wi;
+            betweenness_dependencies(gi, s, true, wi);
+            vector<double> refi(wi.dist.begin(), wi.dist.end());
+
+            // zero picks the width from the weights
+            double deltas[] = {0.0, 0.05, 1.0, 100.0};
+            int ideltas[] = {0, 1, 3, 100};
+            for (int k=0; k < 4; ++k)
+            {
+                for (int nthreads=1; nthreads <= 4; nthreads *= 4)
+                {
+                    vector<double> d(n);
+                    delta_stepping_shortest_paths(g, s, d.begin(),
+                        deltas[k], nthreads);
+                    nfailed += check_vector("delta_stepping_shortest_paths",
+                        w.dist, d, 0.0);
+
+                    vector<int> dint(n);
+                    delta_stepping_shortest_paths(gi, s, dint.begin(),
+                        ideltas[k], nthreads);
+                    nfailed += check_vector("delta_stepping_shortest_paths int",
+                        refi, vector<double>(dint.begin(), dint.end()), 0.0);
+                }
+            }
+        }
+
+        // 87 + w with w just above delta = 0.1 rounds back into the
+        // bucket of 87, and vertex 2 still has to relax its edge
+        int pr[] = {0, 1, 2, 3, 3};
+        int pc[] = {1, 2, 3};
+        double pv[] = {87.0, 0.1 + numeric_limits<double>::epsilon()/16.0, 1.0};
+        simple_csr_matrix<int,double> gp(4, 4, 3, pr, pc, pv);
+        vector<double> dp(4), refp(4);
+        refp[0] = 0.0; refp[1] = pv[0]; refp[2] = refp[1] + pv[1];
+        refp[3] = refp[2] + pv[2];
+        for (int nthreads=1; nthreads <= 4; nthreads *= 4)
+        {
+            delta_stepping_shortest_paths(gp, 0, dp.begin(), 0.1, nthreads);
+            nfailed += check_vector("delta_stepping_shortest_paths rounding",
+                refp, dp, 0.0);
+        }
+
+        // a ring with eight unit edges out of each vertex, and one edge
+        // of 1e9 to an extra vertex; the empty buckets in between must
+        // not take memory
+        int nr = 1000;
+        vector<int> rr(nr+2, 0), rc;
+        vector<double> rv;
+        for (int i=0; i < nr; ++i)
+        {
+            vector<int> row;
+            for (int k=1; k <= 8; ++k) { row.push_back((i+k) % nr); }
+            sort(row.begin(), row.end());
+            for (size_t k=0; k < row.size(); ++k)
+            {
+                rc.push_back(row[k]);
+                rv.push_back(1.0);
+            }
+            if (i == 0) { rc.push_back(nr); rv.push_back(1e9); }
+            rr[i+1] = (int)rc.size();
+        }
+        rr[nr+1] = (int)rc.size();
+        vector<int> riv(rv.begin(), rv.end());
+        simple_csr_matrix<int,double> rg(nr+1, nr+1, (int)rc.size(),
+            &rr[0], &rc[0], &rv[0]);
+        simple_csr_matrix<int,int> rgi(nr+1, nr+1, (int)rc.size(),
+            &rr[0], &rc[0], &riv[0]);
+        betweenness_workspace<int,double> rw;
+        betweenness_dependencies(rg, 0, true, rw);
+        for (int nthreads=1; nthreads <= 4; nthreads *= 4)
+        {
+            vector<double> d(nr+1);
+            delta_stepping_shortest_paths(rg, 0, d.begin(), 0.0, nthreads);
+            nfailed += check_vector("delta_stepping_shortest_paths long edge",
+                rw.dist, d, 0.0);
+            vector<int> dint(nr+1);
+            delta_stepping_shortest_paths(rgi, 0, dint.begin(), 0, nthreads);
+            nfailed += check_vector("delta_stepping_shortest_paths long edge int",
+                rw.dist, vector<double>(dint.begin(), dint.end()), 0.0);
+        }
+        if (delta_stepping_delta(rg) != 1.0)
+        {
+            cout << "delta_stepping_delta: not one on the ring" << endl;
+            nfailed++;
+        }
+
+        if (delta_stepping_delta(g) <= 0.0 || delta_stepping_delta(gi) < 1)
+        {
+            cout << "delta_stepping_delta: not positive" << endl;
+            nfailed++;
+        }
+    }
+
+    if (nfailed > 0)
+    {
+        cout << nfailed << " checks failed" << endl;
+        return (1);
+    }
+    cout << "all checks passed" << endl;
+    return (0);
+}
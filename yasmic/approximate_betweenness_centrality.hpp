@@ -0,0 +1,250 @@
+#ifndef YASMIC_APPROXIMATE_BETWEENNESS_CENTRALITY_HPP
+#define YASMIC_APPROXIMATE_BETWEENNESS_CENTRALITY_HPP
+
+/**
+ * @file approximate_betweenness_centrality.hpp
+ * Estimate the betweenness centrality of a graph in a simple_csr_matrix
+ * from a sample of sources.
+ *
+ * The dependency delta_s(v) of v on a source s is at most n-2, and the
+ * centrality is BC(v) = sum_s delta_s(v).  For k sources drawn uniformly
+ * with replacement, c(v) = n/k sum_s delta_s(v) is an unbiased estimate
+ * of BC(v).  The error is measured on the scale n*(n-2): with
+ * probability at least 1 - delta,
+ *
+ *   |c(v) - BC(v)| <= epsilon*n*(n-2)  for all v.
+ *
+ * Uniform sampling takes k = ln(2n/delta)/(2 epsilon^2) sources from
+ * Hoeffding's inequality with a union bound over the vertices.
+ *
+ * Adaptive sampling starts with a small sample and doubles it.  At each
+ * step the bound is the smaller of the Hoeffding bound and the empirical
+ * Bernstein bound of Maurer and Pontil,
+ *
+ *   sqrt(2 V(v) ln(4n/d)/k) + 7 ln(4n/d)/(3(k-1)),
+ *
+ * with V(v) the sample variance of delta_s(v)/(n-2), maximized over v.
+ * It stops when the bound is below epsilon.  The L steps split delta as
+ * d = delta/(2L), and the last step has enough samples for the Hoeffding
+ * bound, so the guarantee holds wherever it stops.  When the largest
+ * variance is small, the Bernstein bound is much tighter than
+ * Hoeffding's and the sampling stops early.
+ *
+ * Each step runs the sources in parallel with the Brandes kernel from
+ * parallel_betweenness_centrality.hpp.  The result has the number of
+ * sources and the bound that was reached, which is above epsilon only
+ * when max_samples stopped the sampling.  When the sample would need n
+ * sources or more, all the sources are used and the bound is zero.
+ *
+ * D. A. Bader, S. Kintali, K. Madduri, and M. Mihail, "Approximating
+ * betweenness centrality," WAW 2007.
+ * A. Maurer and M. Pontil, "Empirical Bernstein bounds and sample
+ * variance penalization," COLT 2009.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/parallel_betweenness_centrality.hpp>
+
+namespace yasmic
+{
+
+struct betweenness_sampling_options
+{
+    // the error, relative to n*(n-2), and the failure probability
+    double epsilon;
+    double delta;
+
+    // double the sample until the empirical Bernstein bound is below
+    // epsilon, or take the Hoeffding sample at once
+    bool adaptive;
+
+    // use the values of g as edge lengths
+    bool weighted;
+
+    // stop after this many sources, 0 for no limit
+    std::size_t max_samples;
+
+    // the sample size of the first adaptive step
+    std::size_t initial_samples;
+
+    unsigned int seed;
+
+    int nthreads;
+
+    betweenness_sampling_options()
+    : epsilon(0.01), delta(0.1), adaptive(true), weighted(false),
+      max_samples(0), initial_samples(64), seed(5489u),
+      nthreads(parallel_max_threads()) {}
+};
+
+struct betweenness_sampling_result
+{
+    // the number of sources
+    std::size_t samples;
+
+    // the error bound that holds with probability 1 - delta
+    double bound;
+
+    // the number of adaptive steps
+    int steps;
+
+    betweenness_sampling_result() : samples(0), bound(0.0), steps(0) {}
+};
+
+namespace impl
+{
+    /** The Hoeffding bound for k samples in [0,1] and n vertices. */
+    inline double betweenness_hoeffding_bound(std::size_t k, double n,
+        double d)
+    {
+        return (std::sqrt(std::log(2.0*n/d)/(2.0*(double)k)));
+    }
+
+    /** The number of samples for the Hoeffding bound epsilon. */
+    inline std::size_t betweenness_hoeffding_samples(double eps, double n,
+        double d)
+    {
+        return ((std::size_t)std::ceil(std::log(2.0*n/d)/(2.0*eps*eps)));
+    }
+} // namespace impl
+
+/**
+ * Estimate the betweenness centrality from a sample of sources.
+ *
+ * @param g the graph, with positive values when opts.weighted
+ * @param c the output estimate of the centrality, size nrows(g), on the
+ *   same scale as parallel_betweenness_centrality
+ * @param opts the error, the sampling method, and the threads
+ * @param res the number of samples and the bound that was reached
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class CentralityIter>
+void approximate_betweenness_centrality(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    CentralityIter c, const betweenness_sampling_options& opts,
+    betweenness_sampling_result& res)
+{
+    IndexType n = g.nrows;
+    res = betweenness_sampling_result();
+    if (n < 3)
+    {
+        for (IndexType v=0; v < n; ++v) { c[v] = 0; }
+        return;
+    }
+
+    double dn = (double)n;
+    double scale = dn - 2.0;
+
+    // the number of steps and the sample sizes for the guarantee
+    std::size_t k0 = opts.adaptive ? (std::max)(opts.initial_samples,
+        (std::size_t)2) : 0;
+    std::size_t kmax = impl::betweenness_hoeffding_samples(
+        opts.epsilon, dn, opts.delta);
+    int nsteps = 1;
+    if (opts.adaptive)
+    {
+        for (int it=0; it < 64; ++it)
+        {
+            int steps = 1;
+            for (std::size_t k = k0; k < kmax; k *= 2) { ++steps; }
+            std::size_t knext = impl::betweenness_hoeffding_samples(
+                opts.epsilon, dn, opts.delta/(2.0*steps));
+            if (steps == nsteps && knext == kmax) { break; }
+            nsteps = steps;
+            kmax = knext;
+        }
+    }
+    double d = opts.adaptive ? opts.delta/(2.0*nsteps) : opts.delta;
+    if (!opts.adaptive || k0 > kmax) { k0 = kmax; }
+    if (opts.max_samples > 0)
+    {
+        kmax = (std::min)(kmax, opts.max_samples);
+        k0 = (std::min)(k0, kmax);
+    }
+    if (kmax >= (std::size_t)n)
+    {
+        // the sample is not smaller than the exact computation
+        impl::parallel_betweenness_all_sources(g, opts.weighted, c,
+            opts.nthreads);
+        res.samples = n;
+        return;
+    }
+
+    boost::mt19937 gen(opts.seed);
+    boost::uniform_int<IndexType> dist(0, n-1);
+    boost::variate_generator<boost::mt19937&, boost::uniform_int<IndexType> >
+        rng(gen, dist);
+
+    std::vector<double> sum(n, 0.0), sumsq(n, 0.0);
+    std::vector<IndexType> sources;
+    std::size_t k = 0, knext = k0;
+    double bound = 1.0;
+    while (k < kmax)
+    {
+        sources.resize(knext - k);
+        for (std::size_t i=0; i < sources.size(); ++i) { sources[i] = rng(); }
+        impl::parallel_betweenness_sources(g, sources, opts.weighted, sum,
+            opts.adaptive ? &sumsq : (std::vector<double>*)0, opts.nthreads);
+        k = knext;
+        ++res.steps;
+
+        bound = impl::betweenness_hoeffding_bound(k, dn, d);
+        if (opts.adaptive && k > 1)
+        {
+            // the largest empirical Bernstein bound over the vertices
+            double lg = std::log(4.0*dn/d);
+            double vmax = 0.0;
+            for (IndexType v=0; v < n; ++v)
+            {
+                double m = sum[v]/(scale*(double)k);
+                double var = (sumsq[v]/(scale*scale) - (double)k*m*m)
+                    /(double)(k-1);
+                if (var > vmax) { vmax = var; }
+            }
+            double eb = std::sqrt(2.0*vmax*lg/(double)k)
+                + 7.0*lg/(3.0*(double)(k-1));
+            if (eb < bound) { bound = eb; }
+        }
+        if (bound <= opts.epsilon) { break; }
+        knext = (std::min)(2*k, kmax);
+    }
+
+    for (IndexType v=0; v < n; ++v) { c[v] = dn*sum[v]/(double)k; }
+    res.samples = k;
+    res.bound = bound;
+}
+
+/**
+ * Estimate the betweenness centrality with the default options, an
+ * adaptive sample with epsilon = 0.01 and delta = 0.1.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class CentralityIter>
+betweenness_sampling_result approximate_betweenness_centrality(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    CentralityIter c,
+    const betweenness_sampling_options& opts=betweenness_sampling_options())
+{
+    betweenness_sampling_result res;
+    approximate_betweenness_centrality(g, c, opts, res);
+    return (res);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_APPROXIMATE_BETWEENNESS_CENTRALITY_HPP
@@ -0,0 +1,575 @@
+#ifndef YASMIC_BLOCK_CSR_MATRIX_HPP
+#define YASMIC_BLOCK_CSR_MATRIX_HPP
+
+/**
+ * @file block_csr_matrix.hpp
+ * A register blocked compressed sparse row (BCSR) matrix with R x C
+ * dense blocks fixed at compile time.
+ *
+ * Matrices from finite element codes have small dense blocks, one per
+ * pair of nodes.  Storing one column index per block instead of one per
+ * scalar cuts the index traffic of mult by a factor of R*C, and the
+ * block kernels are unrolled by templates so the compiler keeps the
+ * block in registers and vectorizes it.  The price is explicit zeros
+ * where the blocks are not full, see bcsr_fill_ratio and
+ * choose_bcsr_block_size.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+
+#include <yasmic/generic_matrix_operations.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/parallel_util.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    /**
+     * Iterate over the stored entries in one scalar row of a
+     * block_csr_matrix, including the explicit zeros inside the blocks
+     * but not the padding past the last column.
+     */
+    template <class IndexType, class ValueType, class NzSizeType, int R, int C>
+    class bcsr_row_nonzero_const_iterator
+    : public boost::iterator_facade<
+        bcsr_row_nonzero_const_iterator<IndexType, ValueType, NzSizeType, R, C>,
+        yasmic::simple_nonzero<IndexType, ValueType, NzSizeType> const,
+        boost::forward_traversal_tag,
+        yasmic::simple_nonzero<IndexType, ValueType, NzSizeType> const >
+    {
+    public:
+        bcsr_row_nonzero_const_iterator()
+        : _r(0), _k(0), _kend(0), _j(0), _ncols(0), _bj(0), _a(0) {}
+
+        bcsr_row_nonzero_const_iterator(IndexType r, NzSizeType k,
+            NzSizeType kend, IndexType ncols,
+            const IndexType* bj, const ValueType* a)
+        : _r(r), _k(k), _kend(kend), _j(0), _ncols(ncols), _bj(bj), _a(a)
+        {}
+
+    private:
+        IndexType _r;
+        NzSizeType _k, _kend;
+        int _j;
+        IndexType _ncols;
+        const IndexType* _bj;
+        const ValueType* _a;
+
+        friend class boost::iterator_core_access;
+
+        void increment()
+        {
+            if (++_j == C) { _j = 0; ++_k; }
+            // only the last block in a row can hang past the last column
+            else if (_bj[_k]*C + _j >= _ncols) { _j = 0; ++_k; }
+        }
+
+        bool equal(bcsr_row_nonzero_const_iterator const& other) const
+        {
+            return (_k == other._k && _j == other._j);
+        }
+
+        yasmic::simple_nonzero<IndexType, ValueType, NzSizeType>
+        dereference() const
+        {
+            NzSizeType nzi = _k*(R*C) + (_r % R)*C + _j;
+            return (make_simple_nonzero(_r, (IndexType)(_bj[_k]*C + _j),
+                _a[nzi], nzi));
+        }
+    };
+
+    /*
+     * The block kernels.  The templates recurse over the rows and
+     * columns of a block so that every loop over the block is fully
+     * unrolled at compile time.
+     */
+
+    // sum_{j < J} b[j*S]*x[j]
+    template <int J, int S>
+    struct bcsr_dot
+    {
+        template <class ValueType, class Iter>
+        static ValueType apply(const ValueType* b, Iter x)
+        {
+            return (bcsr_dot<J-1,S>::apply(b, x) + b[(J-1)*S]*x[J-1]);
+        }
+    };
+
+    template <int S>
+    struct bcsr_dot<0,S>
+    {
+        template <class ValueType, class Iter>
+        static ValueType apply(const ValueType*, Iter) { return ValueType(); }
+    };
+
+    // acc[i] += b(i,:)*x for i < I
+    template <int I, int C>
+    struct bcsr_block_mult
+    {
+        template <class ValueType, class Iter>
+        static void apply(const ValueType* b, Iter x, ValueType* acc)
+        {
+            bcsr_block_mult<I-1,C>::apply(b, x, acc);
+            acc[I-1] += bcsr_dot<C,1>::apply(b + (I-1)*C, x);
+        }
+    };
+
+    template <int C>
+    struct bcsr_block_mult<0,C>
+    {
+        template <class ValueType, class Iter>
+        static void apply(const ValueType*, Iter, ValueType*) {}
+    };
+
+    // y[j] += b(:,j)'*x for j < J
+    template <int J, int R, int C>
+    struct bcsr_block_trans_mult
+    {
+        template <class ValueType, class Iter1, class Iter2>
+        static void apply(const ValueType* b, Iter1 x, Iter2 y)
+        {
+            bcsr_block_trans_mult<J-1,R,C>::apply(b, x, y);
+            y[J-1] += bcsr_dot<R,C>::apply(b + (J-1), x);
+        }
+    };
+
+    template <int R, int C>
+    struct bcsr_block_trans_mult<0,R,C>
+    {
+        template <class ValueType, class Iter1, class Iter2>
+        static void apply(const ValueType*, Iter1, Iter2) {}
+    };
+} // namespace impl
+
+/**
+ * block_csr_matrix owns its storage, build it with build_bcsr_from_csr.
+ *
+ * Block k covers rows [br*R, br*R+R) and columns [bj[k]*C, bj[k]*C+C)
+ * for the block row br with bi[br] <= k < bi[br+1], and its values are
+ * a[k*R*C ... (k+1)*R*C) in row major order.  The block columns in each
+ * block row are sorted.  The blocks in the last block row and column
+ * are padded with zeros past nrows and ncols.
+ */
+template <class IndexType, class ValueType, int R, int C,
+    class NzSizeType=IndexType>
+struct block_csr_matrix
+{
+    typedef impl::bcsr_row_nonzero_const_iterator<
+        IndexType, ValueType, NzSizeType, R, C> row_nonzero_iterator;
+    typedef boost::counting_iterator<IndexType> row_iterator;
+
+    IndexType nrows;
+    IndexType ncols;
+    // the number of nonzeros in the original matrix
+    NzSizeType nnz;
+
+    IndexType nbrows;
+    IndexType nbcols;
+    NzSizeType nblocks;
+
+    // the block row pointer, size nbrows+1
+    std::vector<NzSizeType> bi;
+    // the block column of each block, size nblocks
+    std::vector<IndexType> bj;
+    // the block values, size nblocks*R*C
+    std::vector<ValueType> a;
+
+    block_csr_matrix()
+        : nrows(0), ncols(0), nnz(0), nbrows(0), nbcols(0), nblocks(0),
+          bi(1, 0) {}
+
+    /**
+     * The fraction of stored values that are explicit zeros added to
+     * fill out the blocks is 1 - 1/fill_ratio().
+     */
+    double fill_ratio() const
+    {
+        return (nnz > 0 ? (double)nblocks*(double)(R*C)/(double)nnz : 1.0);
+    }
+
+    row_iterator begin_rows() const { return (row_iterator(0)); }
+    row_iterator end_rows() const { return (row_iterator(nrows)); }
+
+    row_nonzero_iterator begin_row(IndexType r) const
+    {
+        NzSizeType kend = bi[r/R+1];
+        return (row_nonzero_iterator(r, bi[r/R], kend, ncols,
+            bj.empty() ? 0 : &bj[0], a.empty() ? 0 : &a[0]));
+    }
+
+    row_nonzero_iterator end_row(IndexType r) const
+    {
+        NzSizeType kend = bi[r/R+1];
+        return (row_nonzero_iterator(r, kend, kend, ncols,
+            bj.empty() ? 0 : &bj[0], a.empty() ? 0 : &a[0]));
+    }
+};
+
+template <class IndexType, class ValueType, int R, int C, class NzSizeType>
+struct smatrix_traits< block_csr_matrix<IndexType, ValueType, R, C, NzSizeType> >
+{
+    typedef IndexType index_type;
+    typedef ValueType value_type;
+
+    typedef NzSizeType nz_size_type;
+    typedef NzSizeType nz_index_type;
+
+    typedef typename block_csr_matrix<IndexType, ValueType, R, C,
+        NzSizeType>::row_iterator row_iterator;
+    typedef typename block_csr_matrix<IndexType, ValueType, R, C,
+        NzSizeType>::row_nonzero_iterator row_nonzero_iterator;
+    typedef simple_nonzero<IndexType, ValueType, NzSizeType>
+        row_nonzero_descriptor;
+
+    struct properties
+        : public row_access_tag
+    {};
+};
+
+template <class IndexType, class ValueType, int R, int C, class NzSizeType>
+IndexType nrows(const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m)
+{ return m.nrows; }
+
+template <class IndexType, class ValueType, int R, int C, class NzSizeType>
+IndexType ncols(const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m)
+{ return m.ncols; }
+
+template <class IndexType, class ValueType, int R, int C, class NzSizeType>
+NzSizeType nnz(const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m)
+{ return m.nnz; }
+
+namespace impl
+{
+    // count the r x c blocks needed to hold a csr matrix
+    template <class RowIter, class ColIter, class IndexType>
+    std::size_t bcsr_count_blocks(RowIter ri, ColIter ci,
+        IndexType nr, IndexType nc, int r, int c)
+    {
+        IndexType nbc = (nc + c - 1)/c;
+        std::vector<IndexType> last(nbc, -1);
+        std::size_t nblocks = 0;
+        for (IndexType i=0; i < nr; ++i)
+        {
+            IndexType br = i/r;
+            for (typename std::iterator_traits<RowIter>::value_type
+                 cp = ri[i]; cp < ri[i+1]; ++cp)
+            {
+                IndexType bc = ci[cp]/c;
+                if (last[bc] != br) { last[bc] = br; ++nblocks; }
+            }
+        }
+        return (nblocks);
+    }
+
+    template <class RowIter, class ColIter, class IndexType>
+    double choose_bcsr_block_size(RowIter ri, ColIter ci,
+        IndexType nr, IndexType nc, std::size_t index_bytes,
+        std::size_t value_bytes, int max_r, int max_c, int& r, int& c)
+    {
+        double nz = (double)(ri[nr] - ri[0]);
+        double best_bytes = 0.0, best_fill = 1.0;
+        r = 1; c = 1;
+        for (int tr=1; tr <= max_r; ++tr)
+        {
+            for (int tc=1; tc <= max_c; ++tc)
+            {
+                double nb = (double)bcsr_count_blocks(ri, ci, nr, nc, tr, tc);
+                double bytes = nb*(double)(tr*tc*value_bytes + index_bytes)
+                    + (double)((nr+tr-1)/tr)*(double)index_bytes;
+                if ((tr == 1 && tc == 1) || bytes < best_bytes)
+                {
+                    best_bytes = bytes;
+                    best_fill = nz > 0 ? nb*(double)(tr*tc)/nz : 1.0;
+                    r = tr; c = tc;
+                }
+            }
+        }
+        return (best_fill);
+    }
+
+    template <class RowIter, class ColIter, class ValIter,
+        class IndexType, class ValueType, int R, int C, class NzSizeType>
+    void build_bcsr_from_csr(RowIter ri, ColIter ci, ValIter vi,
+        IndexType nr, IndexType nc,
+        block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m)
+    {
+        m.nrows = nr;
+        m.ncols = nc;
+        m.nnz = (NzSizeType)(ri[nr] - ri[0]);
+        m.nbrows = (nr + R - 1)/R;
+        m.nbcols = (nc + C - 1)/C;
+
+        m.bi.assign(m.nbrows+1, 0);
+        m.bj.clear();
+        m.a.clear();
+
+        // slot[bc] is the block for block column bc in the current
+        // block row, valid when last[bc] is the current block row
+        std::vector<IndexType> last(m.nbcols, -1);
+        std::vector<NzSizeType> slot(m.nbcols);
+        std::vector<IndexType> cols;
+
+        for (IndexType br=0; br < m.nbrows; ++br)
+        {
+            IndexType rend = std::min((IndexType)(br*R + R), nr);
+
+            cols.clear();
+            for (IndexType i=br*R; i < rend; ++i)
+            {
+                for (typename std::iterator_traits<RowIter>::value_type
+                     cp = ri[i]; cp < ri[i+1]; ++cp)
+                {
+                    IndexType bc = ci[cp]/C;
+                    if (last[bc] != br) { last[bc] = br; cols.push_back(bc); }
+                }
+            }
+            std::sort(cols.begin(), cols.end());
+
+            NzSizeType k0 = (NzSizeType)m.bj.size();
+            for (std::size_t k=0; k < cols.size(); ++k)
+            {
+                slot[cols[k]] = k0 + (NzSizeType)k;
+                m.bj.push_back(cols[k]);
+            }
+            m.a.resize(m.bj.size()*(R*C), ValueType());
+
+            // duplicate entries are summed
+            for (IndexType i=br*R; i < rend; ++i)
+            {
+                for (typename std::iterator_traits<RowIter>::value_type
+                     cp = ri[i]; cp < ri[i+1]; ++cp)
+                {
+                    IndexType c = ci[cp];
+                    m.a[slot[c/C]*(R*C) + (i%R)*C + c%C] += vi[cp];
+                }
+            }
+            m.bi[br+1] = (NzSizeType)m.bj.size();
+        }
+        m.nblocks = (NzSizeType)m.bj.size();
+    }
+
+    template <class IndexType, class ValueType, int R, int C,
+        class NzSizeType, class Iter1, class Iter2>
+    void bcsr_mult_block_rows(
+        const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m,
+        IndexType br0, IndexType br1, Iter1 x, Iter2 y)
+    {
+        for (IndexType br = br0; br < br1; ++br)
+        {
+            ValueType acc[R];
+            for (int i=0; i < R; ++i) { acc[i] = ValueType(); }
+
+            for (NzSizeType k = m.bi[br]; k < m.bi[br+1]; ++k)
+            {
+                const ValueType* b = &m.a[k*(R*C)];
+                IndexType c0 = m.bj[k]*C;
+                if (c0 + C <= m.ncols)
+                {
+                    bcsr_block_mult<R,C>::apply(b, x + c0, acc);
+                }
+                else
+                {
+                    // the padded last block column
+                    for (int i=0; i < R; ++i) {
+                        for (IndexType j=0; c0+j < m.ncols; ++j) {
+                            acc[i] += b[i*C+j]*x[c0+j];
+                        }
+                    }
+                }
+            }
+
+            IndexType r0 = br*R;
+            for (int i=0; i < R && r0+i < m.nrows; ++i) { y[r0+i] = acc[i]; }
+        }
+    }
+} // namespace impl
+
+/**
+ * Compute the fill ratio (stored values)/(nonzeros) of a compressed
+ * row matrix stored with r x c blocks.
+ */
+template <class RowIter, class ColIter, class ValIter>
+double bcsr_fill_ratio(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    int r, int c)
+{
+    typedef typename std::iterator_traits<RowIter>::value_type itype;
+    itype nr = nrows(m), nc = ncols(m);
+    double nz = (double)(m._rstart[nr] - m._rstart[0]);
+    double nb = (double)impl::bcsr_count_blocks(m._rstart, m._cstart,
+        nr, nc, r, c);
+    return (nz > 0 ? nb*(double)(r*c)/nz : 1.0);
+}
+
+/**
+ * Pick the block size for a compressed row matrix.
+ *
+ * Every block size up to max_r x max_c is tried, and the one with the
+ * smallest storage, and so the least memory traffic in mult, wins.
+ * That is a large block with a small fill ratio.  Because the block
+ * size of a block_csr_matrix is a template parameter, the caller
+ * switches on r and c to instantiate the matching type.
+ *
+ * @param m the matrix
+ * @param r the number of rows in the best block
+ * @param c the number of columns in the best block
+ * @param max_r the largest block row size to try
+ * @param max_c the largest block column size to try
+ * @return the fill ratio of the best block
+ */
+template <class RowIter, class ColIter, class ValIter>
+double choose_bcsr_block_size(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    int& r, int& c, int max_r=4, int max_c=4)
+{
+    typedef typename std::iterator_traits<RowIter>::value_type itype;
+    typedef typename std::iterator_traits<ValIter>::value_type vtype;
+    itype nr = nrows(m), nc = ncols(m);
+    return (impl::choose_bcsr_block_size(m._rstart, m._cstart, nr, nc,
+        sizeof(itype), sizeof(vtype), max_r, max_c, r, c));
+}
+
+/**
+ * Build a block_csr_matrix from a compressed row matrix.  RowIter must
+ * be a random access iterator.
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class IndexType, class ValueType, int R, int C, class NzSizeType>
+void build_bcsr_from_csr(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& b)
+{
+    IndexType nr = nrows(m), nc = ncols(m);
+    impl::build_bcsr_from_csr(m._rstart, m._cstart, m._vstart, nr, nc, b);
+}
+
+/**
+ * Build a block_csr_matrix from a simple_csr_matrix.
+ */
+template <class IndexType, class ValueType, int R, int C, class NzSizeType>
+void build_bcsr_from_csr(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& b)
+{
+    impl::build_bcsr_from_csr((const NzSizeType*)m.ai, (const IndexType*)m.aj,
+        (const ValueType*)m.a, m.nrows, m.ncols, b);
+}
+
+/**
+ * Compute y = A*x.
+ */
+template <class IndexType, class ValueType, int R, int C, class NzSizeType,
+    class Iter1, class Iter2>
+void mult(const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    impl::bcsr_mult_block_rows(m, (IndexType)0, m.nbrows, x, y);
+}
+
+/**
+ * Compute y = A^T*x.
+ */
+template <class IndexType, class ValueType, int R, int C, class NzSizeType,
+    class Iter1, class Iter2>
+void trans_mult(const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    for (IndexType j=0; j < m.ncols; ++j) { y[j] = ValueType(); }
+
+    for (IndexType br = 0; br < m.nbrows; ++br)
+    {
+        IndexType r0 = br*R;
+        ValueType xb[R];
+        for (int i=0; i < R; ++i) { xb[i] = r0+i < m.nrows ? x[r0+i] : ValueType(); }
+
+        for (NzSizeType k = m.bi[br]; k < m.bi[br+1]; ++k)
+        {
+            const ValueType* b = &m.a[k*(R*C)];
+            IndexType c0 = m.bj[k]*C;
+            if (c0 + C <= m.ncols)
+            {
+                impl::bcsr_block_trans_mult<C,R,C>::apply(b, xb, y + c0);
+            }
+            else
+            {
+                // the padded last block column
+                for (IndexType j=0; c0+j < m.ncols; ++j) {
+                    for (int i=0; i < R; ++i) {
+                        y[c0+j] += b[i*C+j]*xb[i];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Compute y = A*x in parallel over the block rows.
+ */
+template <class IndexType, class ValueType, int R, int C, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_mult(const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m,
+    Iter1 x, Iter2 y, int nthreads)
+{
+    if (nthreads < 1) { nthreads = 1; }
+    if (nthreads == 1)
+    {
+        impl::bcsr_mult_block_rows(m, (IndexType)0, m.nbrows, x, y);
+        return;
+    }
+
+    std::vector<IndexType> part(nthreads+1);
+    nnz_balanced_row_partition(m.bi.begin(), m.nbrows, nthreads, part.begin());
+
+    #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+    for (int p=0; p < nthreads; ++p)
+    {
+        impl::bcsr_mult_block_rows(m, part[p], part[p+1], x, y);
+    }
+}
+
+template <class IndexType, class ValueType, int R, int C, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_mult(const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_mult(m, x, y, parallel_max_threads());
+}
+
+/*
+ * These overloads are required so that a non-const matrix does not
+ * select the nonzero iterator version of mult and trans_mult in
+ * generic_matrix_operations.hpp.
+ */
+template <class IndexType, class ValueType, int R, int C, class NzSizeType,
+    class Iter1, class Iter2>
+void mult(block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& cm = m;
+    mult(cm, x, y);
+}
+
+template <class IndexType, class ValueType, int R, int C, class NzSizeType,
+    class Iter1, class Iter2>
+void trans_mult(block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    const block_csr_matrix<IndexType, ValueType, R, C, NzSizeType>& cm = m;
+    trans_mult(cm, x, y);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_BLOCK_CSR_MATRIX_HPP
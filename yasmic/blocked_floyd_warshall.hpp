@@ -0,0 +1,368 @@
+#ifndef YASMIC_BLOCKED_FLOYD_WARSHALL_HPP
+#define YASMIC_BLOCKED_FLOYD_WARSHALL_HPP
+
+/**
+ * @file blocked_floyd_warshall.hpp
+ * A cache blocked, parallel, vectorized Floyd-Warshall all pairs
+ * shortest path algorithm over a dense row major distance array.
+ *
+ * The n-by-n array is cut into b-by-b tiles.  For each diagonal tile
+ * (K,K) there are three phases:
+ *   1. run Floyd-Warshall on the tile (K,K) by itself;
+ *   2. update the tiles in row K and in column K from the tile (K,K),
+ *      each tile is independent;
+ *   3. update every other tile (I,J) from the tiles (I,K) and (K,J),
+ *      each tile is independent.
+ * The tiles of phases 2 and 3 are split over the threads.  All phases
+ * use the same kernel, which for each k and i does the row update
+ *
+ *   d(i,j) = min(d(i,j), d(i,k) + d(k,j))
+ *
+ * over the j of a tile.  For double, float and int without predecessors
+ * the row update uses AVX2 min/add, picked at runtime as in
+ * simd_csr_kernels.hpp.
+ *
+ * The semantics are those of floyd_warshall_all_pairs_shortest_paths in
+ * boost_mod/floyd_warshall_shortest.hpp with the default closed_plus and
+ * std::less: inf = numeric_limits<Value>::max() is absorbing in the sum,
+ * and d(i,j) and the predecessor p(i,j) = p(k,j) only change when the
+ * new length is strictly shorter.  The distances are the same as the
+ * triple loop; on ties the predecessors may pick another shortest path.
+ * The result is false if there is a negative cycle.
+ *
+ * G. Venkataraman, S. Sahni, and S. Mukhopadhyaya, "A blocked all-pairs
+ * shortest-paths algorithm," Journal of Experimental Algorithmics 8,
+ * 2003.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/simd_csr_kernels.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    /**
+     * di[j] = min(di[j], dik + dk[j]) for j < len, where dk[j] = inf
+     * is skipped; dik is finite.
+     */
+    template <class Value, class Index>
+    inline void fw_row_update_scalar(Value* di, const Value* dk, Value dik,
+        Index len)
+    {
+        const Value inf = (std::numeric_limits<Value>::max)();
+        for (Index j=0; j < len; ++j)
+        {
+            Value dkj = dk[j];
+            Value cand = dik + dkj;
+            if (dkj != inf && cand < di[j]) { di[j] = cand; }
+        }
+    }
+
+    /** The row update with the predecessors, pi[j] = pk[j]. */
+    template <class Value, class Index>
+    inline void fw_row_update_pred(Value* di, const Value* dk, Value dik,
+        Index* pi, const Index* pk, Index len)
+    {
+        const Value inf = (std::numeric_limits<Value>::max)();
+        for (Index j=0; j < len; ++j)
+        {
+            Value dkj = dk[j];
+            Value cand = dik + dkj;
+            if (dkj != inf && cand < di[j])
+            {
+                di[j] = cand;
+                pi[j] = pk[j];
+            }
+        }
+    }
+
+#ifdef YASMIC_SIMD_X86
+
+    template <class Index>
+    YASMIC_SIMD_TARGET("avx2")
+    inline void fw_row_update_avx2(double* di, const double* dk, double dik,
+        Index len)
+    {
+        const __m256d inf = _mm256_set1_pd((std::numeric_limits<double>::max)());
+        const __m256d vik = _mm256_set1_pd(dik);
+        Index j = 0;
+        for (; j+4 <= len; j += 4)
+        {
+            __m256d dkj = _mm256_loadu_pd(dk + j);
+            __m256d dij = _mm256_loadu_pd(di + j);
+            __m256d cand = _mm256_add_pd(vik, dkj);
+            // the infinite lanes of dk keep dij
+            cand = _mm256_blendv_pd(cand, dij, _mm256_cmp_pd(dkj, inf, _CMP_EQ_OQ));
+            _mm256_storeu_pd(di + j, _mm256_min_pd(dij, cand));
+        }
+        fw_row_update_scalar(di + j, dk + j, dik, len - j);
+    }
+
+    template <class Index>
+    YASMIC_SIMD_TARGET("avx2")
+    inline void fw_row_update_avx2(float* di, const float* dk, float dik,
+        Index len)
+    {
+        const __m256 inf = _mm256_set1_ps((std::numeric_limits<float>::max)());
+        const __m256 vik = _mm256_set1_ps(dik);
+        Index j = 0;
+        for (; j+8 <= len; j += 8)
+        {
+            __m256 dkj = _mm256_loadu_ps(dk + j);
+            __m256 dij = _mm256_loadu_ps(di + j);
+            __m256 cand = _mm256_add_ps(vik, dkj);
+            cand = _mm256_blendv_ps(cand, dij, _mm256_cmp_ps(dkj, inf, _CMP_EQ_OQ));
+            _mm256_storeu_ps(di + j, _mm256_min_ps(dij, cand));
+        }
+        fw_row_update_scalar(di + j, dk + j, dik, len - j);
+    }
+
+    template <class Index>
+    YASMIC_SIMD_TARGET("avx2")
+    inline void fw_row_update_avx2(int* di, const int* dk, int dik,
+        Index len)
+    {
+        const __m256i inf = _mm256_set1_epi32((std::numeric_limits<int>::max)());
+        const __m256i vik = _mm256_set1_epi32(dik);
+        Index j = 0;
+        for (; j+8 <= len; j += 8)
+        {
+            __m256i dkj = _mm256_loadu_si256((const __m256i*)(dk + j));
+            __m256i dij = _mm256_loadu_si256((const __m256i*)(di + j));
+            __m256i cand = _mm256_add_epi32(vik, dkj);
+            cand = _mm256_blendv_epi8(cand, dij, _mm256_cmpeq_epi32(dkj, inf));
+            _mm256_storeu_si256((__m256i*)(di + j), _mm256_min_epi32(dij, cand));
+        }
+        fw_row_update_scalar(di + j, dk + j, dik, len - j);
+    }
+
+#endif // YASMIC_SIMD_X86
+
+    /**
+     * Pick the row update.  Only double, float and int have vectorized
+     * versions.
+     */
+    template <class Value, class Index>
+    inline void fw_row_update(simd_level, Value* di, const Value* dk,
+        Value dik, Index len)
+    {
+        fw_row_update_scalar(di, dk, dik, len);
+    }
+
+#ifdef YASMIC_SIMD_X86
+
+    template <class Index>
+    inline void fw_row_update(simd_level level, double* di, const double* dk,
+        double dik, Index len)
+    {
+        if (level >= simd_avx2)
+        {
+            fw_row_update_avx2(di, dk, dik, len);
+            return;
+        }
+        fw_row_update_scalar(di, dk, dik, len);
+    }
+
+    template <class Index>
+    inline void fw_row_update(simd_level level, float* di, const float* dk,
+        float dik, Index len)
+    {
+        if (level >= simd_avx2)
+        {
+            fw_row_update_avx2(di, dk, dik, len);
+            return;
+        }
+        fw_row_update_scalar(di, dk, dik, len);
+    }
+
+    template <class Index>
+    inline void fw_row_update(simd_level level, int* di, const int* dk,
+        int dik, Index len)
+    {
+        if (level >= simd_avx2)
+        {
+            fw_row_update_avx2(di, dk, dik, len);
+            return;
+        }
+        fw_row_update_scalar(di, dk, dik, len);
+    }
+
+#endif // YASMIC_SIMD_X86
+
+    /**
+     * Update the tile of rows [i0,i1) and columns [j0,j1) through the
+     * vertices k in [k0,k1), with k in the outer loop.
+     */
+    template <class Value, class Index>
+    void fw_tile_update(simd_level level, Index n, Value* d, Index* p,
+        Index i0, Index i1, Index j0, Index j1, Index k0, Index k1)
+    {
+        const Value inf = (std::numeric_limits<Value>::max)();
+        std::size_t ld = (std::size_t)n;
+        for (Index k=k0; k < k1; ++k)
+        {
+            const Value* dk = d + (std::size_t)k*ld + j0;
+            for (Index i=i0; i < i1; ++i)
+            {
+                Value* di = d + (std::size_t)i*ld;
+                Value dik = di[k];
+                if (dik == inf) { continue; }
+                if (p)
+                {
+                    fw_row_update_pred(di + j0, dk, dik,
+                        p + (std::size_t)i*ld + j0,
+                        p + (std::size_t)k*ld + j0, j1 - j0);
+                }
+                else
+                {
+                    fw_row_update(level, di + j0, dk, dik, j1 - j0);
+                }
+            }
+        }
+    }
+} // namespace impl
+
+/**
+ * Run Floyd-Warshall on an initialized distance array.
+ *
+ * @param n the number of vertices
+ * @param d the n-by-n row major distances, with
+ *   numeric_limits<Value>::max() for no edge and the edge lengths
+ *   elsewhere, usually d(i,i) = 0
+ * @param p the n-by-n row major predecessors, or null for none
+ * @param nthreads the number of threads
+ * @param block the tile size
+ * @param level the instruction set to use, this is reduced to what
+ *   the processor supports
+ * @return false if there is a negative cycle
+ */
+template <class Value, class Index>
+bool blocked_floyd_warshall(Index n, Value* d, Index* p, int nthreads,
+    Index block, simd_level level)
+{
+    if (level > simd_detect_level()) { level = simd_detect_level(); }
+    if (nthreads < 1) { nthreads = 1; }
+    if (block < 1) { block = 64; }
+
+    Index nb = (n + block - 1)/block;
+    for (Index kb=0; kb < nb; ++kb)
+    {
+        Index k0 = kb*block, k1 = (kb+1)*block < n ? (kb+1)*block : n;
+
+        // phase 1, the diagonal tile
+        impl::fw_tile_update(level, n, d, p, k0, k1, k0, k1, k0, k1);
+
+        // phase 2, the row and column of the diagonal tile
+        int nt2 = 2*(int)nb;
+        #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads)
+        for (int t=0; t < nt2; ++t)
+        {
+            Index b = (Index)(t/2);
+            if (b == kb) { continue; }
+            Index b0 = b*block, b1 = (b+1)*block < n ? (b+1)*block : n;
+            if (t % 2 == 0)
+            {
+                impl::fw_tile_update(level, n, d, p, k0, k1, b0, b1, k0, k1);
+            }
+            else
+            {
+                impl::fw_tile_update(level, n, d, p, b0, b1, k0, k1, k0, k1);
+            }
+        }
+
+        // phase 3, the rest
+        int nt3 = (int)nb*(int)nb;
+        #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads)
+        for (int t=0; t < nt3; ++t)
+        {
+            Index ib = (Index)(t/(int)nb), jb = (Index)(t%(int)nb);
+            if (ib == kb || jb == kb) { continue; }
+            Index i0 = ib*block, i1 = (ib+1)*block < n ? (ib+1)*block : n;
+            Index j0 = jb*block, j1 = (jb+1)*block < n ? (jb+1)*block : n;
+            impl::fw_tile_update(level, n, d, p, i0, i1, j0, j1, k0, k1);
+        }
+    }
+
+    for (Index i=0; i < n; ++i)
+    {
+        if (d[(std::size_t)i*n + i] < Value()) { return (false); }
+    }
+    return (true);
+}
+
+template <class Value, class Index>
+bool blocked_floyd_warshall(Index n, Value* d, Index* p,
+    int nthreads=parallel_max_threads(), Index block=64)
+{
+    return (blocked_floyd_warshall(n, d, p, nthreads, block,
+        simd_detect_level()));
+}
+
+/**
+ * Compute all the shortest path lengths of a graph with the values of
+ * g as the edge lengths.  The arrays are initialized as in
+ * boost::floyd_warshall_all_pairs_shortest_paths: d(i,i) = 0, d(i,j) is
+ * the shortest edge from i to j or inf, p(i,j) = i for an edge and j
+ * otherwise.
+ *
+ * @param g the graph
+ * @param d the output, nrows(g)*nrows(g) row major distances
+ * @param p the output predecessors of the same size, or null for none
+ * @param nthreads the number of threads
+ * @return false if there is a negative cycle
+ */
+template <class IndexType, class ValueType, class NzSizeType>
+bool blocked_floyd_warshall_all_pairs_shortest_paths(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    ValueType* d, IndexType* p, int nthreads=parallel_max_threads())
+{
+    const NzSizeType *ai = g.ai;
+    const IndexType *aj = g.aj;
+    const ValueType *a = g.a;
+    const ValueType inf = (std::numeric_limits<ValueType>::max)();
+    IndexType n = g.nrows;
+    std::size_t ld = (std::size_t)n;
+
+    if (nthreads < 1) { nthreads = 1; }
+
+    #pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (IndexType i=0; i < n; ++i)
+    {
+        ValueType *di = d + (std::size_t)i*ld;
+        for (IndexType j=0; j < n; ++j) { di[j] = inf; }
+        di[i] = ValueType();
+        if (p)
+        {
+            IndexType *pi = p + (std::size_t)i*ld;
+            for (IndexType j=0; j < n; ++j) { pi[j] = j; }
+        }
+        for (NzSizeType k = ai[i]; k < ai[i+1]; ++k)
+        {
+            IndexType j = aj[k];
+            if (di[j] == inf || a[k] < di[j])
+            {
+                di[j] = a[k];
+                if (p) { p[(std::size_t)i*ld + j] = i; }
+            }
+        }
+    }
+
+    return (blocked_floyd_warshall(n, d, p, nthreads, (IndexType)64,
+        simd_detect_level()));
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_BLOCKED_FLOYD_WARSHALL_HPP
@@ -6,6 +6,14 @@
 
 //  Authors: Douglas Gregor
 //           Andrew Lumsdaine
+
+// History
+//
+// 19 October 2026
+// Include boost/property_map/property_map.hpp, boost/property_map.hpp
+// is gone.  See yasmic/parallel_betweenness_centrality.hpp for a
+// parallel version over simple_csr_matrix.
+
 #ifndef BOOST_GRAPH_BRANDES_BETWEENNESS_CENTRALITY_HPP
 #define BOOST_GRAPH_BRANDES_BETWEENNESS_CENTRALITY_HPP
 
@@ -19,7 +27,7 @@
 #include <boost/type_traits/is_convertible.hpp>
 #include <boost/type_traits/is_same.hpp>
 #include <boost/mpl/if.hpp>
-#include <boost/property_map.hpp>
+#include <boost/property_map/property_map.hpp>
 #include <boost/graph/named_function_params.hpp>
 #include <algorithm>
 
@@ -11,9 +11,61 @@
 #ifndef BOOST_GRAPH_CLUSTERING_COEFFICIENTS_HPP
 #define BOOST_GRAPH_CLUSTERING_COEFFICIENTS_HPP
 
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/graph_concepts.hpp>
+#include <boost/graph/visitors.hpp>
+#include <boost/graph/named_function_params.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+/*
+ *clustering_coefficients
+ *
+ *Requirement:
+ *      AdjacencyGraph, VertexListGraph
+ */
+
+// History
+//
+// 19 October 2026
+// Finished the implementation: the triangles are listed by intersecting
+// the sorted neighbor lists of a degree ordered orientation instead of
+// marking the neighbors of each vertex.  Added the on_triangle event
+// and the number of triangles as the return value.  Removed the
+// edge_weight dispatch, there is no weighted version.
+
 namespace boost {
+
+    // The local clustering coefficient of a vertex v with d neighbors is
+    // the fraction of the d*(d-1)/2 pairs of neighbors that are adjacent,
+    // or 0 when d < 2.  Self loops and repeated edges are ignored.
+    //
+    // Each edge is oriented from the endpoint of smaller (degree, index)
+    // to the larger one, so each vertex keeps at most sqrt(2m) out
+    // neighbors.  Each triangle (u,v,w) with u < v < w in that order is
+    // then found exactly once, as a common out neighbor w of the edge
+    // (u,v), by merging the two sorted out lists.  This takes
+    // O(m sqrt(m)) time and O(n+m) memory.
+    //
+    // The visitor gets triangle(u,v,w,g) for each triangle.  See
+    // yasmic/triangle_counts.hpp for a parallel version on
+    // simple_csr_matrix.
+    //
+    // The method is from:
+    // Thomas Schank and Dorothea Wagner, "Finding, counting and listing
+    // all triangles in large graphs, an experimental study," WEA 2005.
+
+    struct on_triangle {
+        enum { num = detail::on_edge_not_minimized_num + 1 };
+    };
+
     template <class Visitor, class Graph>
-    class DFSVisitorConcept {
+    class ClusteringCoefficientsVisitorConcept {
     public:
         void constraints() {
             function_requires< CopyConstructibleConcept<Visitor> >();
@@ -23,89 +75,37 @@ namespace boost {
         Visitor vis;
         Graph g;
         typename graph_traits<Graph>::vertex_descriptor x,y,z;
-        typename graph_traits<Graph>::edge_descriptor e;
     };
 
     namespace detail {
-        /*template <class Vertex, class IndMap>
-        struct in_indicator_pred
-	        : public std::unary_function<Vertex, bool>
-        {
-	        in_indicator_pred(IndMap indmap, Vertex src)
-		        : i(indmap), u(src)
-	        {}
-	        IndMap i;
-            Vertex u;
-	        bool operator() (const Vertex &v) const
-	        {   
-		        return (i[v] > 0) && (u != v);
-	        }
-        };*/
-
-        template <class Graph, class CCMap, class CCVisitor, class ColorMap>
-        clustering_coefficients_impl(
-            const Graph& g, CCMap cc, CCVisitor vis, ColorMap color_map)
+        template <class Visitor, class Vertex, class Graph>
+        inline void invoke_triangle_dispatch(Visitor& v, Vertex x, Vertex y,
+            Vertex z, const Graph& g, mpl::true_)
+        { v(x,y,z,g); }
+
+        template <class Visitor, class Vertex, class Graph>
+        inline void invoke_triangle_dispatch(Visitor&, Vertex, Vertex,
+            Vertex, const Graph&, mpl::false_)
+        {}
+
+        template <class Visitor, class Vertex, class Graph>
+        inline void invoke_triangle_visitors(Visitor& v,
+            Vertex x, Vertex y, Vertex z, const Graph& g)
         {
-            function_requires<AdjacencyGraphConcept<Graph> >();
-            function_requires<CCVisitorConcept<CCVisitor, Graph> >();
-
-            typedef typename graph_traits<Graph>::vertex_descriptor vertex;
-            typename property_traits<CCMap>::value_type cc_type;
-
-            typename graph_traits<Graph>::vertex_iterator vi,vi_end;
-            typename graph_traits<Graph>::adjacency_iterator ai,ai_end;
-            typedef color_traits<ColorValue> Color;
-            for (tie(vi,vi_end)=vertices(g);vi!=vi_end;++vi) {
-                put(color_map, *vi, Color::white());
-            }
-            for (tie(vi,vi_end)=vertices(g);vi!=vi_end;++vi) {
-                vertex v = *vi;
-                for (tie(ai,ai_end)=adjacacent_vertices(v,g);ai!=ai_end;++ai) {
-                    put(color_map, *ai, Color::black());
-                }
-                typename graph_traits<Graph>::degree_size_type d = out_degree(v,g);
-                cc_type cur_cc = 0;
-                for (tie(ai,ai_end)=adjacacent_vertices(v,g);ai!=ai_end;++ai) {
-                    vertex w = *ai;
-                    // don't count self-loops
-                    if (v == w) { --d; continue; }
-                    typename graph_traits<Graph>::adjacency_iterator ai2,ai2_end;
-                    for (tie(ai2,ai2_end) = adjacenct_vertices(w,g);ai2!=ai2_end;++ai2) {
-                        if (get(color_map, *ai2) == Color::black()) {
-                            vis.triangle(v,w,*ai2);
-                            ++cur_cc;
-                        }
-                    }
-                }
-                if (d>1) {  
-                    cc[v] = cur_cc/(cc_type)(d*(d-1));
-                } else {
-                    cc[v] = (cc_type)0;
-                }
-
-                // reset the colors
-                for (tie(ai,ai_end)=adjacacent_vertices(v,g);ai!=ai_end;++ai) {
-                    put(color_map, *ai, Color::white());
-                }
-            }
+            typedef typename is_same<typename Visitor::event_filter,
+                on_triangle>::type IsSameTag;
+            invoke_triangle_dispatch(v, x, y, z, g, IsSameTag());
         }
 
-        template <typename WeightMap>
-        struct clustering_coefficients_dispatch1 {
-            template <class Graph, class CCMap, class VertexIndexMap>
-            static void run(const Graph& g, CCMap cc, 
-                VertexIndexMap vind, WeightMap wm)
-            {}
-        };
-        template <>
-        struct clustering_coefficients_dispatch1<detail::error_property_not_found> {
-            template <class Graph, class CCMap, class VertexIndexMap>
-            static void run(const Graph& g, CCMap cc, 
-                VertexIndexMap vind, detail::error_property_not_found)
-            {
-            }
-        };
-
+        template <class Visitor, class Rest, class Vertex, class Graph>
+        inline void invoke_triangle_visitors(std::pair<Visitor, Rest>& vlist,
+            Vertex x, Vertex y, Vertex z, const Graph& g)
+        {
+            typedef typename is_same<typename Visitor::event_filter,
+                on_triangle>::type IsSameTag;
+            invoke_triangle_dispatch(vlist.first, x, y, z, g, IsSameTag());
+            invoke_triangle_visitors(vlist.second, x, y, z, g);
+        }
     } // namespace detail
 
     template <class Visitors = null_visitor>
@@ -116,7 +116,7 @@ namespace boost {
 
         template <class Vertex, class Graph>
         void triangle(Vertex x, Vertex y, Vertex z, const Graph& g) {
-            invoke_visitors(m_vis, x, y, z, g, ::boost::on_triangle());
+            detail::invoke_triangle_visitors(m_vis, x, y, z, g);
         }
 
         BOOST_GRAPH_EVENT_STUB(on_triangle,clustering_coefficients)
@@ -131,30 +131,115 @@ namespace boost {
     }
     typedef clustering_coefficients_visitor<> default_clustering_coefficients_visitor;
 
+    namespace detail {
+        template <class Graph, class CCMap, class CCVisitor, class VertexIndexMap>
+        std::size_t clustering_coefficients_impl(
+            const Graph& g, CCMap cc, CCVisitor vis, VertexIndexMap vind)
+        {
+            function_requires<AdjacencyGraphConcept<Graph> >();
+            function_requires<VertexListGraphConcept<Graph> >();
+            function_requires<ClusteringCoefficientsVisitorConcept<CCVisitor, Graph> >();
+
+            typedef typename graph_traits<Graph>::vertex_descriptor vertex;
+            typedef typename property_traits<CCMap>::value_type cc_type;
+            typedef typename graph_traits<Graph>::vertices_size_type size_type;
+
+            typename graph_traits<Graph>::vertex_iterator vi,vi_end;
+            typename graph_traits<Graph>::adjacency_iterator ai,ai_end;
+
+            size_type n = num_vertices(g);
+            std::vector<vertex> verts(n);
+            for (tie(vi,vi_end)=vertices(g);vi!=vi_end;++vi) {
+                verts[get(vind,*vi)] = *vi;
+            }
+
+            // the sorted neighbors of each vertex without self loops
+            // and repeated edges
+            std::vector<std::size_t> start(n+1, 0);
+            std::vector<size_type> adj;
+            for (size_type i=0; i < n; ++i) {
+                std::size_t s = adj.size();
+                for (tie(ai,ai_end)=adjacent_vertices(verts[i],g);ai!=ai_end;++ai) {
+                    size_type j = get(vind,*ai);
+                    if (j != i) { adj.push_back(j); }
+                }
+                std::sort(adj.begin()+s, adj.end());
+                adj.erase(std::unique(adj.begin()+s, adj.end()), adj.end());
+                start[i+1] = adj.size();
+            }
+
+            // keep the neighbors of larger (degree, index), which keeps
+            // the lists sorted
+            std::vector<std::size_t> ostart(n+1, 0);
+            std::vector<size_type> oadj;
+            oadj.reserve(adj.size()/2);
+            for (size_type i=0; i < n; ++i) {
+                std::size_t di = start[i+1] - start[i];
+                for (std::size_t p=start[i]; p < start[i+1]; ++p) {
+                    size_type j = adj[p];
+                    std::size_t dj = start[j+1] - start[j];
+                    if (di < dj || (di == dj && i < j)) { oadj.push_back(j); }
+                }
+                ostart[i+1] = oadj.size();
+            }
+
+            std::vector<std::size_t> tri(n, 0);
+            std::size_t ntri = 0;
+            for (size_type u=0; u < n; ++u) {
+                for (std::size_t p=ostart[u]; p < ostart[u+1]; ++p) {
+                    size_type v = oadj[p];
+                    std::size_t pu = ostart[u], pv = ostart[v];
+                    while (pu < ostart[u+1] && pv < ostart[v+1]) {
+                        size_type wu = oadj[pu], wv = oadj[pv];
+                        if (wu < wv) { ++pu; }
+                        else if (wv < wu) { ++pv; }
+                        else {
+                            vis.triangle(verts[u], verts[v], verts[wu], g);
+                            ++tri[u]; ++tri[v]; ++tri[wu];
+                            ++ntri;
+                            ++pu; ++pv;
+                        }
+                    }
+                }
+            }
+
+            for (size_type i=0; i < n; ++i) {
+                std::size_t d = start[i+1] - start[i];
+                if (d > 1) {
+                    put(cc, verts[i], (cc_type)(2*tri[i])/(cc_type)(d*(d-1)));
+                } else {
+                    put(cc, verts[i], (cc_type)0);
+                }
+            }
+            return ntri;
+        }
+    } // namespace detail
+
     template <class Graph, class CCMap, class P, class T, class R>
-    void clustering_coefficients(const Graph& g, CCMap cc,
+    std::size_t clustering_coefficients(const Graph& g, CCMap cc,
         const bgl_named_params<P,T,R>& params)
     {
-        typedef bgl_named_params<P,T,R> named_params;
-        typedef typename property_value<named_params, edge_weight_t>::type ew;
-        detail::clustering_coefficients_dispatch1<ew>::run(
-            g, cc,
-            choose_const_pmap(get_param(params, vertex_index), g, vertex_index),
-            get_param(params, edge_weight)
-            );
+        return detail::clustering_coefficients_impl(g, cc,
+            choose_param(get_param(params, graph_visitor),
+                make_clustering_coefficients_visitor(null_visitor())),
+            choose_const_pmap(get_param(params, vertex_index), g, vertex_index));
     }
-    
+
     template <class Graph, class CCMap>
-    void clustering_coefficients(const Graph& g, CCMap cc)
+    std::size_t clustering_coefficients(const Graph& g, CCMap cc)
     {
+        return detail::clustering_coefficients_impl(g, cc,
+            make_clustering_coefficients_visitor(null_visitor()),
+            get(vertex_index, g));
     }
 
     template <class Graph, class CCMap, class CCVisitor>
-    void clustering_coefficients(const Graph& g, CCMap cc,
-        )
+    std::size_t clustering_coefficients(const Graph& g, CCMap cc,
+        CCVisitor vis)
     {
+        return detail::clustering_coefficients_impl(g, cc, vis,
+            get(vertex_index, g));
     }
 } // namespace boost
 
 #endif // BOOST_GRAPH_CLUSTERING_COEFFICIENTS_HPP
-
@@ -15,6 +15,10 @@
 #include <boost/pending/indirect_cmp.hpp>
 #include <boost/graph/breadth_first_search.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/mpl/bool.hpp>
+#include <vector>
+#include <limits>
 
 /*
  *core_numbers
@@ -30,6 +34,10 @@
 //
 // 8 February 2008
 // Fixed headers and missing typename
+//
+// 19 October 2026
+// Added a bucket queue for integer weights, and clamped the weighted
+// core numbers at the current core so removed vertices are not updated
 
 namespace boost {
 
@@ -37,7 +45,14 @@ namespace boost {
     // of a graph for unweighted graphs.
     //
     // and a O((n+m) log n) algorithm to compute the in-edge-weight core
-    // numbers of a weighted graph.
+    // numbers of a weighted graph.  When the core values and weights are
+    // integers, the weights are non-negative, and the largest in-weight
+    // is at most n+m, the weighted version uses a bucket queue instead
+    // and takes O(n+m) time.
+    //
+    // The weighted core numbers are the generalized cores of Batagelj
+    // and Zaversnik for the in-weight: removing v with core c_v sets
+    // c_u = max(c_v, c_u - w(v,u)) for the vertices u still in the graph.
     //
     // The linear algorithm comes from:
     // Vladimir Batagelj and Matjaz Zaversnik, "An O(m) Algorithm for Cores 
@@ -154,8 +169,10 @@ namespace boost {
                     vertex u = target(*oi,g);
                     // if c[u] > c[v], then u is still in the graph,
                     if (get(c,u) > v_cn) {
-                        // remove the edge
-                        put(c,u,get(c,u)-get(wm,*oi));
+                        // remove the edge, but not below the current core
+                        typename property_traits<CoreMap>::value_type 
+                            c_u = get(c,u) - get(wm,*oi);
+                        put(c,u,c_u < v_cn ? v_cn : c_u);
                         Q.update(u);
                     }
                 }
@@ -164,11 +181,107 @@ namespace boost {
             return (v_cn);
         }
         
+        // the weighted version with a bucket queue for integer core
+        // values, the buckets are doubly linked lists of vertex indices
+        // and max_c is the largest initial core value
+        template <typename Graph, typename CoreMap, typename EdgeWeightMap,
+            typename IndexMap, typename Visitor>
+        typename property_traits<CoreMap>::value_type
+        core_numbers_bucket_impl(Graph& g, CoreMap c, EdgeWeightMap wm,
+            IndexMap im, std::size_t max_c, Visitor vis)
+        {
+            typedef typename property_traits<CoreMap>::value_type D;
+            typedef typename graph_traits<Graph>::vertex_descriptor vertex;
+            typedef typename graph_traits<Graph>::vertices_size_type size_type;
+            const size_type none = (std::numeric_limits<size_type>::max)();
+            
+            size_type n = num_vertices(g);
+            std::vector<vertex> vert(n);
+            std::vector<size_type> head(max_c+1, none), next(n), prev(n);
+            std::vector<char> removed(n, 0);
+            
+            typename graph_traits<Graph>::vertex_iterator vi,vi_end;
+            for (tie(vi,vi_end) = vertices(g); vi!=vi_end; ++vi) {
+                size_type i = get(im,*vi);
+                std::size_t b = (std::size_t)get(c,*vi);
+                vert[i] = *vi;
+                prev[i] = none;
+                next[i] = head[b];
+                if (head[b] != none) { prev[head[b]] = i; }
+                head[b] = i;
+            }
+            
+            D v_cn = 0;
+            std::size_t cur = 0;
+            for (size_type count = 0; count < n; ++count) {
+                // the core values never decrease, so neither does cur
+                while (head[cur] == none) { ++cur; }
+                size_type vi = head[cur];
+                head[cur] = next[vi];
+                if (head[cur] != none) { prev[head[cur]] = none; }
+                removed[vi] = 1;
+                
+                vertex v = vert[vi];
+                vis.examine_vertex(v,g);
+                v_cn = get(c,v);
+                typename graph_traits<Graph>::out_edge_iterator oi,oi_end;
+                for (tie(oi,oi_end) = out_edges(v,g); oi!=oi_end; ++oi) {
+                    vis.examine_edge(*oi,g);
+                    vertex u = target(*oi,g);
+                    size_type ui = get(im,u);
+                    if (removed[ui] || get(c,u) <= v_cn) { continue; }
+                    // unlink u from its bucket
+                    std::size_t b = (std::size_t)get(c,u);
+                    if (prev[ui] != none) { next[prev[ui]] = next[ui]; }
+                    else { head[b] = next[ui]; }
+                    if (next[ui] != none) { prev[next[ui]] = prev[ui]; }
+                    // remove the edge, but not below the current core
+                    D c_u = get(c,u) - get(wm,*oi);
+                    if (c_u < v_cn) { c_u = v_cn; }
+                    put(c,u,c_u);
+                    b = (std::size_t)c_u;
+                    prev[ui] = none;
+                    next[ui] = head[b];
+                    if (head[b] != none) { prev[head[b]] = ui; }
+                    head[b] = ui;
+                }
+                vis.finish_vertex(v,g);
+            }
+            return (v_cn);
+        }
+        
+        template <typename Graph, typename CoreMap, typename EdgeWeightMap,
+            typename IndexMap, typename CoreNumVisitor>
+        typename property_traits<CoreMap>::value_type 
+        core_numbers_dispatch(Graph&g, CoreMap c, EdgeWeightMap wm,
+            IndexMap im, CoreNumVisitor vis, mpl::true_)
+        {
+            // check that the weights and the in-weights allow buckets
+            typedef typename property_traits<CoreMap>::value_type D;
+            bool buckets = true;
+            D max_c = 0;
+            std::size_t m = 0;
+            typename graph_traits<Graph>::vertex_iterator vi,vi_end;
+            typename graph_traits<Graph>::out_edge_iterator ei,ei_end;
+            for (tie(vi,vi_end) = vertices(g); vi!=vi_end; ++vi) {
+                if (get(c,*vi) > max_c) { max_c = get(c,*vi); }
+                for (tie(ei,ei_end) = out_edges(*vi,g); ei!=ei_end; ++ei) {
+                    if (get(wm,*ei) < 0) { buckets = false; }
+                    ++m;
+                }
+            }
+            if (buckets && (std::size_t)max_c <= (std::size_t)num_vertices(g) + m) {
+                return core_numbers_bucket_impl(g, c, wm, im, 
+                    (std::size_t)max_c, vis);
+            }
+            return core_numbers_dispatch(g, c, wm, im, vis, mpl::false_());
+        }
+        
         template <typename Graph, typename CoreMap, typename EdgeWeightMap,
             typename IndexMap, typename CoreNumVisitor>
         typename property_traits<CoreMap>::value_type 
         core_numbers_dispatch(Graph&g, CoreMap c, EdgeWeightMap wm,
-            IndexMap im, CoreNumVisitor vis)
+            IndexMap im, CoreNumVisitor vis, mpl::false_)
         {
             typedef typename property_traits<CoreMap>::value_type D;
             typedef std::less<D> Cmp;
@@ -310,8 +423,11 @@ namespace boost {
         CoreNumVisitor vis)
     {
         typedef typename graph_traits<Graph>::vertices_size_type size_type;
+        typedef typename property_traits<CoreMap>::value_type D;
+        typedef typename property_traits<EdgeWeightMap>::value_type W;
         detail::compute_in_degree_map(g,c,wm);
-        return detail::core_numbers_dispatch(g,c,wm,vim,vis);
+        return detail::core_numbers_dispatch(g,c,wm,vim,vis,
+            mpl::bool_<is_integral<D>::value && is_integral<W>::value>());
     }
     
     // non-named parameter version for the weighted case
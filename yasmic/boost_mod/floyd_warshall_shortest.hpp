@@ -9,6 +9,13 @@
 
 // Predecessor Matrix implementation added by David Gleich, 2006.
 
+// History
+//
+// 19 October 2026
+// Include boost/property_map/property_map.hpp, boost/property_map.hpp
+// is gone.  See yasmic/blocked_floyd_warshall.hpp for a blocked and
+// parallel version over a dense distance array.
+
 /*
   This file implements the functions
 
@@ -31,7 +38,7 @@
 #ifndef BOOST_GRAPH_FLOYD_WARSHALL_HPP
 #define BOOST_GRAPH_FLOYD_WARSHALL_HPP
 
-#include <boost/property_map.hpp>
+#include <boost/property_map/property_map.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/named_function_params.hpp>
 #include <boost/graph/graph_concepts.hpp>
@@ -0,0 +1,376 @@
+#ifndef YASMIC_CSB_MATRIX_HPP
+#define YASMIC_CSB_MATRIX_HPP
+
+/**
+ * @file csb_matrix.hpp
+ * A compressed sparse blocks (CSB) matrix.
+ *
+ * The matrix is tiled into beta x beta blocks, stored block row by
+ * block row.  Each nonzero stores its row and column offset inside its
+ * block packed into a single unsigned int, and the value.  Because the
+ * storage is symmetric in the rows and columns, both y = A*x (split over
+ * block rows) and y = A^T*x (split over block columns) run in parallel
+ * without write conflicts from one copy of the matrix.  This uses about
+ * half the memory of storing the matrix and its transpose as in
+ * simple_row_and_column_matrix.
+ *
+ * The algorithm comes from:
+ * Aydin Buluc, Jeremy T. Fineman, Matteo Frigo, John R. Gilbert, and
+ * Charles E. Leiserson, "Parallel Sparse Matrix-Vector and
+ * Matrix-Transpose-Vector Multiplication Using Compressed Sparse
+ * Blocks."  SPAA 2009.
+ *
+ * Unlike that paper, a single very dense block row (or block column) is
+ * not split further, so it is processed by one thread.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/parallel_util.hpp>
+
+namespace yasmic
+{
+
+/**
+ * csb_matrix owns its storage, build it with build_csb_from_csr.
+ */
+template <class IndexType, class ValueType, class NzSizeType=IndexType>
+struct csb_matrix
+{
+    IndexType nrows;
+    IndexType ncols;
+    NzSizeType nnz;
+
+    // beta = 1 << lg_beta
+    int lg_beta;
+    IndexType nbrows;
+    IndexType nbcols;
+
+    // the start of each block in rc and a, size nbrows*nbcols+1
+    std::vector<NzSizeType> blk;
+    // the row offset << lg_beta | the column offset, size nnz
+    std::vector<unsigned int> rc;
+    // the values, size nnz
+    std::vector<ValueType> a;
+
+    // the cumulative nonzero counts by block row and block column,
+    // used to balance the parallel work; size nbrows+1 and nbcols+1
+    std::vector<NzSizeType> brow_nnz;
+    std::vector<NzSizeType> bcol_nnz;
+
+    csb_matrix()
+        : nrows(0), ncols(0), nnz(0), lg_beta(0), nbrows(0), nbcols(0) {}
+};
+
+template <class IndexType, class ValueType, class NzSizeType>
+struct smatrix_traits< csb_matrix<IndexType, ValueType, NzSizeType> >
+{
+    typedef IndexType index_type;
+    typedef ValueType value_type;
+
+    typedef NzSizeType nz_size_type;
+    typedef NzSizeType nz_index_type;
+
+    typedef no_property_tag properties;
+};
+
+template <class IndexType, class ValueType, class NzSizeType>
+IndexType nrows(const csb_matrix<IndexType, ValueType, NzSizeType>& m)
+{ return m.nrows; }
+
+template <class IndexType, class ValueType, class NzSizeType>
+IndexType ncols(const csb_matrix<IndexType, ValueType, NzSizeType>& m)
+{ return m.ncols; }
+
+template <class IndexType, class ValueType, class NzSizeType>
+NzSizeType nnz(const csb_matrix<IndexType, ValueType, NzSizeType>& m)
+{ return m.nnz; }
+
+/**
+ * Choose the block size for a csb matrix, the smallest power of two
+ * at least sqrt(max(nrows,ncols)), between 4 and 2^16.
+ *
+ * @return log2 of the block size
+ */
+template <class IndexType>
+int csb_default_lg_beta(IndexType nrows, IndexType ncols)
+{
+    double n = (double)(nrows > ncols ? nrows : ncols);
+    int lg = 2;
+    while (lg < 16 && (double)(1 << lg)*(double)(1 << lg) < n) { ++lg; }
+    return lg;
+}
+
+namespace impl
+{
+    template <class RowIter, class ColIter, class ValIter,
+        class IndexType, class ValueType, class NzSizeType>
+    void build_csb_from_csr(RowIter ri, ColIter ci, ValIter vi,
+        IndexType nr, IndexType nc, int lg_beta,
+        csb_matrix<IndexType, ValueType, NzSizeType>& m)
+    {
+        if (lg_beta <= 0) { lg_beta = csb_default_lg_beta(nr, nc); }
+        if (lg_beta > 16) { lg_beta = 16; }
+
+        IndexType beta = (IndexType)1 << lg_beta;
+        unsigned int mask = (unsigned int)beta - 1;
+
+        m.nrows = nr;
+        m.ncols = nc;
+        m.nnz = (NzSizeType)(ri[nr] - ri[0]);
+        m.lg_beta = lg_beta;
+        m.nbrows = (nr + beta - 1) >> lg_beta;
+        m.nbcols = (nc + beta - 1) >> lg_beta;
+
+        IndexType nbc = m.nbcols;
+        m.blk.assign((std::size_t)m.nbrows*(std::size_t)nbc + 1, 0);
+        m.rc.resize(m.nnz);
+        m.a.resize(m.nnz);
+        m.brow_nnz.assign(m.nbrows+1, 0);
+        m.bcol_nnz.assign(nbc+1, 0);
+
+        // count the entries in each block
+        for (IndexType r=0; r < nr; ++r)
+        {
+            std::size_t boff = (std::size_t)(r >> lg_beta)*(std::size_t)nbc + 1;
+            for (NzSizeType cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                ++m.blk[boff + (ci[cp] >> lg_beta)];
+                ++m.bcol_nnz[(ci[cp] >> lg_beta) + 1];
+            }
+            m.brow_nnz[(r >> lg_beta) + 1] += ri[r+1] - ri[r];
+        }
+        for (std::size_t b=1; b < m.blk.size(); ++b) { m.blk[b] += m.blk[b-1]; }
+        for (IndexType b=0; b < m.nbrows; ++b) { m.brow_nnz[b+1] += m.brow_nnz[b]; }
+        for (IndexType b=0; b < nbc; ++b) { m.bcol_nnz[b+1] += m.bcol_nnz[b]; }
+
+        // place the entries, within a block they stay in row order
+        std::vector<NzSizeType> next(m.blk.begin(), m.blk.end()-1);
+        for (IndexType r=0; r < nr; ++r)
+        {
+            std::size_t boff = (std::size_t)(r >> lg_beta)*(std::size_t)nbc;
+            unsigned int roff = ((unsigned int)r & mask) << lg_beta;
+            for (NzSizeType cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                IndexType c = ci[cp];
+                NzSizeType p = next[boff + (c >> lg_beta)]++;
+                m.rc[p] = roff | ((unsigned int)c & mask);
+                m.a[p] = vi[cp];
+            }
+        }
+    }
+
+    template <class IndexType, class ValueType, class NzSizeType,
+        class Iter1, class Iter2>
+    void csb_mult_block_rows(
+        const csb_matrix<IndexType, ValueType, NzSizeType>& m,
+        IndexType br0, IndexType br1, Iter1 x, Iter2 y)
+    {
+        int lg = m.lg_beta;
+        unsigned int mask = (1u << lg) - 1;
+        for (IndexType br = br0; br < br1; ++br)
+        {
+            IndexType rbase = br << lg;
+            IndexType rend = rbase + ((IndexType)1 << lg);
+            if (rend > m.nrows) { rend = m.nrows; }
+            for (IndexType r = rbase; r < rend; ++r) { y[r] = ValueType(); }
+
+            std::size_t boff = (std::size_t)br*(std::size_t)m.nbcols;
+            for (IndexType bc = 0; bc < m.nbcols; ++bc)
+            {
+                IndexType cbase = bc << lg;
+                for (NzSizeType p = m.blk[boff+bc]; p < m.blk[boff+bc+1]; ++p)
+                {
+                    unsigned int rc = m.rc[p];
+                    y[rbase + (rc >> lg)] += m.a[p]*x[cbase + (rc & mask)];
+                }
+            }
+        }
+    }
+
+    template <class IndexType, class ValueType, class NzSizeType,
+        class Iter1, class Iter2>
+    void csb_trans_mult_block_cols(
+        const csb_matrix<IndexType, ValueType, NzSizeType>& m,
+        IndexType bc0, IndexType bc1, Iter1 x, Iter2 y)
+    {
+        int lg = m.lg_beta;
+        unsigned int mask = (1u << lg) - 1;
+        for (IndexType bc = bc0; bc < bc1; ++bc)
+        {
+            IndexType cbase = bc << lg;
+            IndexType cend = cbase + ((IndexType)1 << lg);
+            if (cend > m.ncols) { cend = m.ncols; }
+            for (IndexType c = cbase; c < cend; ++c) { y[c] = ValueType(); }
+
+            for (IndexType br = 0; br < m.nbrows; ++br)
+            {
+                IndexType rbase = br << lg;
+                std::size_t b = (std::size_t)br*(std::size_t)m.nbcols + bc;
+                for (NzSizeType p = m.blk[b]; p < m.blk[b+1]; ++p)
+                {
+                    unsigned int rc = m.rc[p];
+                    y[cbase + (rc & mask)] += m.a[p]*x[rbase + (rc >> lg)];
+                }
+            }
+        }
+    }
+} // namespace impl
+
+/**
+ * Build a csb matrix from a simple_csr_matrix.
+ *
+ * @param m the csr matrix
+ * @param b the output csb matrix
+ * @param lg_beta log2 of the block size, 0 picks csb_default_lg_beta;
+ *   at most 16
+ */
+template <class IndexType, class ValueType, class NzSizeType>
+void build_csb_from_csr(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    csb_matrix<IndexType, ValueType, NzSizeType>& b, int lg_beta=0)
+{
+    impl::build_csb_from_csr((const NzSizeType*)m.ai, (const IndexType*)m.aj,
+        (const ValueType*)m.a, m.nrows, m.ncols, lg_beta, b);
+}
+
+/**
+ * Build a csb matrix from a compressed_row_matrix.  RowIter must be a
+ * random access iterator.
+ *
+ * @param m the compressed row matrix
+ * @param b the output csb matrix
+ * @param lg_beta log2 of the block size, 0 picks csb_default_lg_beta;
+ *   at most 16
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class IndexType, class ValueType, class NzSizeType>
+void build_csb_from_csr(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    csb_matrix<IndexType, ValueType, NzSizeType>& b, int lg_beta=0)
+{
+    IndexType nr = nrows(m), nc = ncols(m);
+    impl::build_csb_from_csr(m._rstart, m._cstart, m._vstart,
+        nr, nc, lg_beta, b);
+}
+
+/**
+ * Compute y = A*x in parallel over the block rows.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_mult(const csb_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, int nthreads)
+{
+    if (nthreads < 1) { nthreads = 1; }
+    if (nthreads == 1)
+    {
+        impl::csb_mult_block_rows(m, (IndexType)0, m.nbrows, x, y);
+        return;
+    }
+
+    std::vector<IndexType> part(nthreads+1);
+    nnz_balanced_row_partition(m.brow_nnz.begin(), m.nbrows, nthreads,
+        part.begin());
+
+    #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+    for (int p=0; p < nthreads; ++p)
+    {
+        impl::csb_mult_block_rows(m, part[p], part[p+1], x, y);
+    }
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_mult(const csb_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_mult(m, x, y, parallel_max_threads());
+}
+
+/**
+ * Compute y = A^T*x in parallel over the block columns.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_trans_mult(const csb_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, int nthreads)
+{
+    if (nthreads < 1) { nthreads = 1; }
+    if (nthreads == 1)
+    {
+        impl::csb_trans_mult_block_cols(m, (IndexType)0, m.nbcols, x, y);
+        return;
+    }
+
+    std::vector<IndexType> part(nthreads+1);
+    nnz_balanced_row_partition(m.bcol_nnz.begin(), m.nbcols, nthreads,
+        part.begin());
+
+    #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+    for (int p=0; p < nthreads; ++p)
+    {
+        impl::csb_trans_mult_block_cols(m, part[p], part[p+1], x, y);
+    }
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_trans_mult(const csb_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_trans_mult(m, x, y, parallel_max_threads());
+}
+
+/**
+ * Compute y = A*x.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void mult(const csb_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_mult(m, x, y, 1);
+}
+
+/**
+ * Compute y = A^T*x.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void trans_mult(const csb_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_trans_mult(m, x, y, 1);
+}
+
+/*
+ * These overloads are required so that a non-const matrix does not
+ * select the nonzero iterator version of mult and trans_mult in
+ * generic_matrix_operations.hpp.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void mult(csb_matrix<IndexType, ValueType, NzSizeType>& m, Iter1 x, Iter2 y)
+{
+    parallel_mult(m, x, y, 1);
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void trans_mult(csb_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_trans_mult(m, x, y, 1);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_CSB_MATRIX_HPP
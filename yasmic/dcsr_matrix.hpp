@@ -0,0 +1,364 @@
+#ifndef YASMIC_DCSR_MATRIX_HPP
+#define YASMIC_DCSR_MATRIX_HPP
+
+/**
+ * @file dcsr_matrix.hpp
+ * A doubly compressed sparse row (DCSR) matrix for hypersparse
+ * matrices, where most of the rows are empty.
+ *
+ * A compressed_row_matrix stores nrows+1 row offsets and its nonzero
+ * iterator steps over the empty rows one at a time.  dcsr_matrix only
+ * stores the ids of the non-empty rows and their offsets, so the memory
+ * and the cost of iterating over the rows or nonzeros scale with the
+ * number of nonzeros instead of the number of rows.
+ *
+ * The row iterator only visits the non-empty rows, and row_nonzeros
+ * finds a row with a binary search over the non-empty row ids.
+ *
+ * The format comes from:
+ * Aydin Buluc and John R. Gilbert, "On the representation and
+ * multiplication of hypersparse matrices."  IPDPS 2008.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <yasmic/generic_matrix_operations.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    /**
+     * The nonzero iterator for the dcsr matrix.  There are no empty
+     * rows to skip, so each step is constant time.
+     */
+    template <class IndexType, class ValueType, class NzSizeType>
+    class dcsr_nonzero_const_iterator
+    : public boost::iterator_facade<
+        dcsr_nonzero_const_iterator<IndexType, ValueType, NzSizeType>,
+        yasmic::simple_nonzero<IndexType, ValueType, NzSizeType> const,
+        boost::forward_traversal_tag,
+        yasmic::simple_nonzero<IndexType, ValueType, NzSizeType> const >
+    {
+    public:
+        dcsr_nonzero_const_iterator()
+        : _ids(0), _rp(0), _cols(0), _vals(0), _p(0), _k(0) {}
+
+        dcsr_nonzero_const_iterator(const IndexType* ids, const NzSizeType* rp,
+            const IndexType* cols, const ValueType* vals,
+            IndexType p, NzSizeType k)
+        : _ids(ids), _rp(rp), _cols(cols), _vals(vals), _p(p), _k(k) {}
+
+    private:
+        friend class boost::iterator_core_access;
+
+        const IndexType* _ids;
+        const NzSizeType* _rp;
+        const IndexType* _cols;
+        const ValueType* _vals;
+
+        // the position in the non-empty rows, and in the nonzeros
+        IndexType _p;
+        NzSizeType _k;
+
+        inline void increment()
+        {
+            ++_k;
+            if (_k == _rp[_p+1]) { ++_p; }
+        }
+
+        bool equal(dcsr_nonzero_const_iterator const& other) const
+        {
+            return (_k == other._k);
+        }
+
+        yasmic::simple_nonzero<IndexType, ValueType, NzSizeType>
+        dereference() const
+        {
+            return (make_simple_nonzero(_ids[_p], _cols[_k], _vals[_k], _k));
+        }
+    };
+} // namespace impl
+
+/**
+ * dcsr_matrix owns its storage, build it with build_dcsr_from_csr.
+ *
+ * Non-empty row _rowids[p] has the nonzeros _rp[p] ... _rp[p+1]-1 of
+ * _cols and _vals.  The row ids are sorted.
+ */
+template <class IndexType, class ValueType, class NzSizeType=IndexType>
+class dcsr_matrix
+{
+public:
+    typedef IndexType size_type;
+    typedef IndexType index_type;
+    typedef ValueType value_type;
+    typedef NzSizeType nz_index_type;
+
+    typedef simple_nonzero<index_type, value_type, nz_index_type> nonzero_descriptor;
+    typedef impl::dcsr_nonzero_const_iterator<IndexType, ValueType, NzSizeType>
+        nonzero_iterator;
+
+    typedef typename std::vector<IndexType>::const_iterator row_iterator;
+
+    typedef nonzero_descriptor row_nonzero_descriptor;
+    typedef impl::crm_row_nonzero_const_iterator<NzSizeType,
+        const IndexType*, const ValueType*> row_nonzero_iterator;
+
+    typedef const ValueType* value_iterator;
+
+    typedef void column_iterator;
+    typedef void column_nonzero_iterator;
+
+    typedef void properties;
+
+    dcsr_matrix()
+    : _nrows(0), _ncols(0), _nnz(0), _rp(1, 0) {}
+
+    nonzero_iterator begin_nonzeros() const
+    {
+        return (nonzero_iterator(ids(), &_rp[0], cols(), vals(), 0, 0));
+    }
+
+    nonzero_iterator end_nonzeros() const
+    {
+        return (nonzero_iterator(ids(), &_rp[0], cols(), vals(),
+            nzrows(), _nnz));
+    }
+
+    inline std::pair<size_type, size_type> dimensions() const
+    {
+        return (std::make_pair(_nrows, _ncols));
+    }
+
+    inline nz_index_type nnz() const
+    {
+        return (_nnz);
+    }
+
+    /** The number of non-empty rows. */
+    inline size_type nzrows() const
+    {
+        return ((size_type)_rowids.size());
+    }
+
+    row_iterator begin_rows() const
+    {
+        return (_rowids.begin());
+    }
+
+    row_iterator end_rows() const
+    {
+        return (_rowids.end());
+    }
+
+    row_nonzero_iterator begin_row(index_type r) const
+    {
+        NzSizeType nzi = _rp[find_row(r)];
+        return (row_nonzero_iterator(r, nzi, cols() + nzi, vals() + nzi));
+    }
+
+    row_nonzero_iterator end_row(index_type r) const
+    {
+        IndexType p = find_row(r);
+        NzSizeType nzi = (p < nzrows() && _rowids[p] == r) ? _rp[p+1] : _rp[p];
+        return (row_nonzero_iterator(r, nzi, cols() + nzi, vals() + nzi));
+    }
+
+    value_iterator begin_values() const
+    {
+        return (vals());
+    }
+
+    value_iterator end_values() const
+    {
+        return (vals() + _nnz);
+    }
+
+    /**
+     * The position of row r in the non-empty rows, or the position
+     * where it would go if it is empty.
+     */
+    IndexType find_row(index_type r) const
+    {
+        return ((IndexType)(std::lower_bound(_rowids.begin(), _rowids.end(), r)
+            - _rowids.begin()));
+    }
+
+    size_type _nrows, _ncols;
+    nz_index_type _nnz;
+
+    std::vector<IndexType> _rowids;
+    std::vector<NzSizeType> _rp;
+    std::vector<IndexType> _cols;
+    std::vector<ValueType> _vals;
+
+private:
+    const IndexType* ids() const { return (_rowids.empty() ? 0 : &_rowids[0]); }
+    const IndexType* cols() const { return (_cols.empty() ? 0 : &_cols[0]); }
+    const ValueType* vals() const { return (_vals.empty() ? 0 : &_vals[0]); }
+};
+
+namespace impl
+{
+    template <class RowIter, class ColIter, class ValIter,
+        class IndexType, class ValueType, class NzSizeType>
+    void build_dcsr_from_csr(RowIter ri, ColIter ci, ValIter vi,
+        IndexType nr, IndexType nc,
+        dcsr_matrix<IndexType, ValueType, NzSizeType>& m)
+    {
+        m._nrows = nr;
+        m._ncols = nc;
+        m._nnz = (NzSizeType)(ri[nr] - ri[0]);
+
+        m._rowids.clear();
+        m._rp.assign(1, 0);
+        m._cols.resize(m._nnz);
+        m._vals.resize(m._nnz);
+
+        NzSizeType k = 0;
+        for (IndexType r=0; r < nr; ++r)
+        {
+            if (ri[r+1] == ri[r]) { continue; }
+            for (typename std::iterator_traits<RowIter>::value_type
+                 cp = ri[r]; cp < ri[r+1]; ++cp, ++k)
+            {
+                m._cols[k] = ci[cp];
+                m._vals[k] = vi[cp];
+            }
+            m._rowids.push_back(r);
+            m._rp.push_back(k);
+        }
+    }
+} // namespace impl
+
+/**
+ * Build a dcsr matrix from a compressed_row_matrix.  This is the only
+ * operation on a dcsr matrix that looks at every row.
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class IndexType, class ValueType, class NzSizeType>
+void build_dcsr_from_csr(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    dcsr_matrix<IndexType, ValueType, NzSizeType>& d)
+{
+    IndexType nr = nrows(m), nc = ncols(m);
+    impl::build_dcsr_from_csr(m._rstart, m._cstart, m._vstart, nr, nc, d);
+}
+
+/**
+ * Build a dcsr matrix from a simple_csr_matrix.
+ */
+template <class IndexType, class ValueType, class NzSizeType>
+void build_dcsr_from_csr(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    dcsr_matrix<IndexType, ValueType, NzSizeType>& d)
+{
+    impl::build_dcsr_from_csr((const NzSizeType*)m.ai, (const IndexType*)m.aj,
+        (const ValueType*)m.a, m.nrows, m.ncols, d);
+}
+
+/**
+ * Expand a dcsr matrix to compressed sparse row arrays, for example
+ * for a simple_csr_matrix or a compressed_row_matrix.
+ *
+ * @param m the dcsr matrix
+ * @param ai the row pointer, size nrows(m)+1
+ * @param aj the column indices, size nnz(m)
+ * @param a the values, size nnz(m)
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class RowIter, class ColIter, class ValIter>
+void build_csr_from_dcsr(const dcsr_matrix<IndexType, ValueType, NzSizeType>& m,
+    RowIter ai, ColIter aj, ValIter a)
+{
+    std::copy(m._cols.begin(), m._cols.end(), aj);
+    std::copy(m._vals.begin(), m._vals.end(), a);
+
+    IndexType r = 0;
+    for (IndexType p=0; p < m.nzrows(); ++p)
+    {
+        for (; r <= m._rowids[p]; ++r) { ai[r] = m._rp[p]; }
+    }
+    for (; r <= m._nrows; ++r) { ai[r] = m._nnz; }
+}
+
+/**
+ * Compute y = A*x.  Only the non-empty rows are visited, but all of y
+ * is set.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void mult(const dcsr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    for (IndexType r=0; r < m._nrows; ++r) { y[r] = ValueType(); }
+
+    for (IndexType p=0; p < m.nzrows(); ++p)
+    {
+        ValueType sum = ValueType();
+        for (NzSizeType k = m._rp[p]; k < m._rp[p+1]; ++k)
+        {
+            sum += m._vals[k]*x[m._cols[k]];
+        }
+        y[m._rowids[p]] = sum;
+    }
+}
+
+/**
+ * Compute y = A^T*x.  Only the non-empty rows of A are visited, so
+ * only the entries of x at those rows are read.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void trans_mult(const dcsr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    for (IndexType c=0; c < m._ncols; ++c) { y[c] = ValueType(); }
+
+    for (IndexType p=0; p < m.nzrows(); ++p)
+    {
+        ValueType xr = x[m._rowids[p]];
+        for (NzSizeType k = m._rp[p]; k < m._rp[p+1]; ++k)
+        {
+            y[m._cols[k]] += m._vals[k]*xr;
+        }
+    }
+}
+
+/*
+ * These overloads are required so that a non-const matrix does not
+ * select the nonzero iterator version of mult and trans_mult in
+ * generic_matrix_operations.hpp.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void mult(dcsr_matrix<IndexType, ValueType, NzSizeType>& m, Iter1 x, Iter2 y)
+{
+    const dcsr_matrix<IndexType, ValueType, NzSizeType>& cm = m;
+    mult(cm, x, y);
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void trans_mult(dcsr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    const dcsr_matrix<IndexType, ValueType, NzSizeType>& cm = m;
+    trans_mult(cm, x, y);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_DCSR_MATRIX_HPP
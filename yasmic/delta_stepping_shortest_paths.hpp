@@ -0,0 +1,310 @@
+#ifndef YASMIC_DELTA_STEPPING_SHORTEST_PATHS_HPP
+#define YASMIC_DELTA_STEPPING_SHORTEST_PATHS_HPP
+
+/**
+ * @file delta_stepping_shortest_paths.hpp
+ * Parallel single source shortest paths by delta-stepping over the
+ * values of a simple_csr_matrix.
+ *
+ * The tentative distances are kept in buckets of width delta, bucket b
+ * has the vertices with b*delta <= d(v) < (b+1)*delta.  The edges are
+ * light when w <= delta and heavy otherwise.  The smallest non-empty
+ * bucket is emptied in phases: all of its vertices relax their light
+ * edges at once, which may put vertices back into the same bucket, until
+ * it stays empty.  Then the vertices removed from it relax their heavy
+ * edges, which land in a later bucket.  In floating point d(u) + w can
+ * round back into the current bucket, and then it gets another light
+ * round.  With delta at the smallest weight this is Dijkstra's
+ * algorithm, and with delta at infinity it is Bellman-Ford.
+ *
+ * Each vertex is owned by one thread, a contiguous block of indices,
+ * and only its owner writes its distance and keeps its buckets.  A
+ * relaxation phase splits the current frontier over the threads
+ * dynamically; each thread reads the distances and sends the requests
+ * (v, d(u) + w) that improve d(v) to the owner of v.  After a barrier,
+ * each owner applies its requests and moves the vertices between its
+ * buckets.  There are no atomic updates, and the distances are the same
+ * as a serial run.  The buckets use lazy deletion, so a vertex that
+ * moves leaves a stale entry that is skipped later.
+ *
+ * When delta is not given, it is the 1/d quantile of a sample of the
+ * weights, with d the average degree, so each vertex has about one
+ * light edge.  This is w_max/d for uniform weights, as suggested by
+ * Meyer and Sanders, and one for unit weights, where the buckets are
+ * the levels of a breadth first search.
+ *
+ * The weights must not be negative; integer and floating point values
+ * both work.  Unreachable vertices get numeric_limits<Value>::max().
+ * Each thread keeps only its non-empty buckets, in a map from the
+ * bucket number, so a few long edges do not cost memory for the empty
+ * buckets in between.  The memory is O(n) plus the bucket entries and
+ * requests, at most one of each for each successful relaxation.
+ *
+ * U. Meyer and P. Sanders, "Delta-stepping: a parallelizable shortest
+ * path algorithm," Journal of Algorithms 49(1), 2003.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <map>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    /**
+     * The bucket of a distance, the distances past the largest
+     * std::size_t share the last bucket.
+     */
+    template <class Value>
+    inline std::size_t delta_stepping_bucket(Value d, Value delta)
+    {
+        const std::size_t last = (std::numeric_limits<std::size_t>::max)() - 1;
+        double q = (double)(d/delta);
+        return (q >= (double)last ? last : (std::size_t)q);
+    }
+} // namespace impl
+
+/**
+ * Pick the bucket width for delta_stepping_shortest_paths from the
+ * weights of g.
+ *
+ * @param g the graph with non-negative values
+ * @return the 1/d quantile of a sample of the values, with d the average
+ *   degree, or the smallest positive value if that is zero, or one if
+ *   every value is zero
+ */
+template <class IndexType, class ValueType, class NzSizeType>
+ValueType delta_stepping_delta(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g)
+{
+    const std::size_t max_sample = 4096;
+    std::size_t nz = (std::size_t)g.nnz;
+    if (nz == 0 || g.nrows == 0) { return (ValueType(1)); }
+
+    std::size_t stride = nz > max_sample ? nz/max_sample : 1;
+    std::vector<ValueType> w;
+    w.reserve(nz/stride + 1);
+    for (std::size_t k=0; k < nz; k += stride) { w.push_back(g.a[k]); }
+
+    double davg = (double)nz/(double)g.nrows;
+    double q = davg > 1.0 ? 1.0/davg : 1.0;
+    std::size_t k = (std::size_t)(q*(double)(w.size() - 1));
+    std::nth_element(w.begin(), w.begin() + k, w.end());
+    ValueType delta = w[k];
+    if (delta > ValueType(0)) { return (delta); }
+
+    // the smallest positive weight in the sample
+    for (std::size_t i=0; i < w.size(); ++i)
+    {
+        if (w[i] > ValueType(0) && (delta == ValueType(0) || w[i] < delta))
+        {
+            delta = w[i];
+        }
+    }
+    return (delta > ValueType(0) ? delta : ValueType(1));
+}
+
+/**
+ * Compute the shortest path distances from one source.
+ *
+ * @param g the graph, with non-negative values as edge weights
+ * @param s the source
+ * @param d the output distances, size nrows(g)
+ * @param delta the bucket width, or zero to pick it with
+ *   delta_stepping_delta
+ * @param nthreads the number of threads
+ * @return the bucket width that was used
+ */
+template <class IndexType, class ValueType, class NzSizeType, class DistIter>
+ValueType delta_stepping_shortest_paths(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    IndexType s, DistIter d, ValueType delta=ValueType(0),
+    int nthreads=parallel_max_threads())
+{
+    typedef std::pair<IndexType, ValueType> request;
+    const NzSizeType *ai = g.ai;
+    const IndexType *aj = g.aj;
+    const ValueType *a = g.a;
+    const ValueType inf = (std::numeric_limits<ValueType>::max)();
+    const std::size_t none = (std::numeric_limits<std::size_t>::max)();
+    IndexType n = g.nrows;
+
+    if (!(delta > ValueType(0))) { delta = delta_stepping_delta(g); }
+    if (nthreads < 1) { nthreads = 1; }
+    if (n == 0) { return (delta); }
+
+    std::vector<ValueType> dist(n, inf);
+    dist[s] = ValueType(0);
+
+    // the state of each thread, indexed by the thread that owns it
+    typedef std::map<std::size_t, std::vector<IndexType> > bucket_map;
+    std::vector<bucket_map> bins;
+    std::vector< std::vector< std::vector<request> > > reqs;
+    std::vector< std::vector<IndexType> > front, settled;
+    std::vector<std::size_t> offset, next;
+
+    // the last phase a vertex was in the frontier, and the last round
+    // it was settled in, written only by the owner
+    std::vector<std::size_t> in_front(n, 0), in_settled(n, 0);
+
+    // a heavy relaxation that rounds down into the current bucket
+    std::vector<char> again;
+
+    std::vector<IndexType> frontier;
+    IndexType chunk = 1;
+    std::size_t b = 0;
+    int nt = 1;
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        int tid = parallel_thread_num();
+
+        #pragma omp single
+        {
+            nt = parallel_num_threads();
+            bins.resize(nt);
+            reqs.assign(nt, std::vector< std::vector<request> >(nt));
+            front.resize(nt);
+            settled.resize(nt);
+            offset.resize(nt+1);
+            next.resize(nt);
+            again.resize(nt);
+            chunk = (IndexType)((n + nt - 1)/nt);
+            bins[s/chunk][0].push_back(s);
+        }
+
+        std::vector<IndexType> cur;
+        std::size_t phase = 0, round = 1;
+        while (true)
+        {
+            bool light = true;
+            ++round;
+            while (true)
+            {
+                // the vertices of my bucket b, without the stale entries
+                ++phase;
+                front[tid].clear();
+                typename bucket_map::iterator bi = bins[tid].find(b);
+                if (light && bi != bins[tid].end())
+                {
+                    cur.clear();
+                    cur.swap(bi->second);
+                    for (std::size_t i=0; i < cur.size(); ++i)
+                    {
+                        IndexType v = cur[i];
+                        if (impl::delta_stepping_bucket(dist[v], delta) != b
+                            || in_front[v] == phase) { continue; }
+                        in_front[v] = phase;
+                        front[tid].push_back(v);
+                        if (in_settled[v] != round)
+                        {
+                            in_settled[v] = round;
+                            settled[tid].push_back(v);
+                        }
+                    }
+                }
+                else if (!light)
+                {
+                    front[tid].swap(settled[tid]);
+                }
+
+                #pragma omp barrier
+                #pragma omp single
+                {
+                    offset[0] = 0;
+                    for (int t=0; t < nt; ++t)
+                    {
+                        offset[t+1] = offset[t] + front[t].size();
+                    }
+                    frontier.resize(offset[nt]);
+                }
+                std::copy(front[tid].begin(), front[tid].end(),
+                    frontier.begin() + offset[tid]);
+                #pragma omp barrier
+                if (light && offset[nt] == 0) { light = false; continue; }
+
+                // send the improving relaxations to the owners
+                long nf = (long)offset[nt];
+                #pragma omp for schedule(dynamic,64)
+                for (long i=0; i < nf; ++i)
+                {
+                    IndexType u = frontier[i];
+                    ValueType du = dist[u];
+                    for (NzSizeType p = ai[u]; p < ai[u+1]; ++p)
+                    {
+                        if ((a[p] <= delta) != light) { continue; }
+                        IndexType v = aj[p];
+                        ValueType dv = du + a[p];
+                        if (dv < dist[v])
+                        {
+                            reqs[tid][v/chunk].push_back(request(v, dv));
+                        }
+                    }
+                }
+
+                // apply the requests for my vertices
+                for (int t=0; t < nt; ++t)
+                {
+                    std::vector<request>& r = reqs[t][tid];
+                    for (std::size_t i=0; i < r.size(); ++i)
+                    {
+                        IndexType v = r[i].first;
+                        ValueType dv = r[i].second;
+                        if (!(dv < dist[v])) { continue; }
+                        dist[v] = dv;
+                        bins[tid][impl::delta_stepping_bucket(dv, delta)]
+                            .push_back(v);
+                    }
+                    r.clear();
+                }
+                if (light) { continue; }
+
+                // in floating point, d(u) + w with w > delta can still
+                // round into bucket b, then empty it again
+                bi = bins[tid].find(b);
+                again[tid] = bi != bins[tid].end() && !bi->second.empty();
+                settled[tid].clear();
+                #pragma omp barrier
+                bool more = false;
+                for (int t=0; t < nt; ++t) { more = more || again[t]; }
+                if (!more) { break; }
+                light = true;
+                ++round;
+            }
+
+            // my next non-empty bucket, the later buckets are only made
+            // by a push so none of them are empty
+            bins[tid].erase(b);
+            front[tid].clear();
+            settled[tid].clear();
+            next[tid] = bins[tid].empty() ? none : bins[tid].begin()->first;
+            #pragma omp barrier
+            #pragma omp single
+            {
+                b = none;
+                for (int t=0; t < nt; ++t) { b = (std::min)(b, next[t]); }
+            }
+            if (b == none) { break; }
+        }
+    }
+
+    for (IndexType v=0; v < n; ++v) { d[v] = dist[v]; }
+    return (delta);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_DELTA_STEPPING_SHORTEST_PATHS_HPP
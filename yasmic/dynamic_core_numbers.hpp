@@ -0,0 +1,409 @@
+#ifndef YASMIC_DYNAMIC_CORE_NUMBERS_HPP
+#define YASMIC_DYNAMIC_CORE_NUMBERS_HPP
+
+/**
+ * @file dynamic_core_numbers.hpp
+ * Core numbers of an undirected graph kept up to date under edge
+ * insertions and deletions.
+ *
+ * The graph is a compressed sparse row base with a flag for each
+ * deleted base edge, plus a list of inserted neighbors per vertex.
+ * When the deleted and inserted edges pass half of the base, the
+ * edges are merged back into a new base with compact.
+ *
+ * Each edge update uses the traversal algorithm of Sariyuce, Gedik,
+ * Jacques-Silva, Wu, and Catalyurek, "Streaming algorithms for k-core
+ * decomposition," VLDB 2013.  An update of the edge (u,v) with
+ * K = min(core(u), core(v)) only changes vertices of core K connected
+ * to u or v through vertices of core K, and by at most one.
+ *
+ *   insert: visit the vertices of core K from the root, keeping those
+ *     with more than K neighbors of core >= K as candidates and only
+ *     expanding through candidates.  Then evict the candidates that
+ *     lose that count as their neighbors are ruled out.  The rest move
+ *     to core K+1.
+ *   delete: a vertex of core K with fewer than K neighbors of core
+ *     >= K moves to K-1, and its neighbors of core K are checked in
+ *     turn.  Only those vertices and their neighbors are visited.
+ *
+ * The work for an update is proportional to the edges of the visited
+ * vertices, not the graph.  The scratch arrays have one entry per
+ * vertex, are allocated once, and only the visited entries are reset.
+ * The number of vertices with each core number is kept as well.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/parallel_core_numbers.hpp>
+
+namespace yasmic
+{
+
+template <class Index, class NzSizeType=Index>
+class dynamic_core_numbers
+{
+public:
+    typedef Index index_type;
+    typedef NzSizeType nz_index_type;
+
+    /**
+     * Copy the graph and compute its core numbers.  The graph must be
+     * undirected with both directions of each edge stored, without self
+     * loops or duplicate edges.
+     */
+    template <class ValueType>
+    dynamic_core_numbers(const simple_csr_matrix<Index, ValueType, NzSizeType>& g)
+    : _n(g.nrows), _core(g.nrows), _visited(0)
+    {
+        _rp.assign(g.ai, g.ai + g.nrows + 1);
+        _cols.assign(g.aj + g.ai[0], g.aj + g.ai[g.nrows]);
+        if (_rp[0] != 0)
+        {
+            NzSizeType r0 = _rp[0];
+            for (Index v=0; v <= _n; ++v) { _rp[v] -= r0; }
+        }
+        _alive.assign(_cols.size(), 1);
+        _ndead = 0;
+        _delta.resize(_n);
+        _ndelta = 0;
+
+        _mark.assign(_n, 0);
+        _cd.assign(_n, 0);
+
+        parallel_core_numbers(g, _core.begin());
+        for (Index v=0; v < _n; ++v) { count_core(_core[v], 1); }
+    }
+
+    Index num_vertices() const { return (_n); }
+
+    /** The number of stored edges, each undirected edge counts twice. */
+    std::size_t num_edges() const
+    {
+        return (_cols.size() - _ndead + _ndelta);
+    }
+
+    Index core(Index v) const { return (_core[v]); }
+    const std::vector<Index>& cores() const { return (_core); }
+
+    Index max_core() const
+    {
+        return (_count.empty() ? 0 : (Index)(_count.size()-1));
+    }
+
+    /** The number of vertices with core number k. */
+    std::size_t count(Index k) const
+    {
+        return ((std::size_t)k < _count.size() ? _count[k] : 0);
+    }
+
+    /**
+     * The number of vertices visited by the updates since the last
+     * call to reset_visited, a measure of their work.
+     */
+    std::size_t visited() const { return (_visited); }
+    void reset_visited() { _visited = 0; }
+
+    bool has_edge(Index u, Index v) const
+    {
+        NzSizeType p;
+        std::size_t q;
+        return (find_edge(u, v, p, q) != 0);
+    }
+
+    /**
+     * Insert the undirected edge (u,v) and update the core numbers.
+     * @return false if the edge was there already or is a self loop
+     */
+    bool insert_edge(Index u, Index v)
+    {
+        if (u == v || has_edge(u, v)) { return (false); }
+        _delta[u].push_back(v);
+        _delta[v].push_back(u);
+        _ndelta += 2;
+
+        Index k = (std::min)(_core[u], _core[v]);
+        insert_update(_core[u] == k ? u : v, k);
+        maybe_compact();
+        return (true);
+    }
+
+    /**
+     * Remove the undirected edge (u,v) and update the core numbers.
+     * @return false if the edge was not there
+     */
+    bool remove_edge(Index u, Index v)
+    {
+        if (u == v || !has_edge(u, v)) { return (false); }
+        unlink(u, v);
+        unlink(v, u);
+
+        Index k = (std::min)(_core[u], _core[v]);
+        remove_update(u, v, k);
+        maybe_compact();
+        return (true);
+    }
+
+    /**
+     * Apply a batch of edge deletions and then insertions, each is a
+     * range of std::pair<Index,Index>.
+     *
+     * @return the number of edges that changed the graph
+     */
+    template <class RemoveIter, class InsertIter>
+    std::size_t update(RemoveIter rfirst, RemoveIter rlast,
+        InsertIter ifirst, InsertIter ilast)
+    {
+        std::size_t nchanged = 0;
+        for (; rfirst != rlast; ++rfirst)
+        {
+            if (remove_edge(rfirst->first, rfirst->second)) { ++nchanged; }
+        }
+        for (; ifirst != ilast; ++ifirst)
+        {
+            if (insert_edge(ifirst->first, ifirst->second)) { ++nchanged; }
+        }
+        return (nchanged);
+    }
+
+    /**
+     * Write the current graph in compressed sparse row form.
+     */
+    void build_csr(std::vector<NzSizeType>& rp, std::vector<Index>& cols) const
+    {
+        rp.resize(_n+1);
+        cols.clear();
+        cols.reserve(num_edges());
+        rp[0] = 0;
+        for (Index v=0; v < _n; ++v)
+        {
+            for (NzSizeType p = _rp[v]; p < _rp[v+1]; ++p)
+            {
+                if (_alive[p]) { cols.push_back(_cols[p]); }
+            }
+            cols.insert(cols.end(), _delta[v].begin(), _delta[v].end());
+            rp[v+1] = (NzSizeType)cols.size();
+        }
+    }
+
+    /** Merge the inserted and deleted edges into the base. */
+    void compact()
+    {
+        std::vector<NzSizeType> rp;
+        std::vector<Index> cols;
+        build_csr(rp, cols);
+        _rp.swap(rp);
+        _cols.swap(cols);
+        _alive.assign(_cols.size(), 1);
+        _ndead = 0;
+        for (Index v=0; v < _n; ++v) { _delta[v].clear(); }
+        _ndelta = 0;
+    }
+
+private:
+    static Index none() { return ((Index)-1); }
+
+    // the number of neighbor slots of w, and the neighbor in slot i, or
+    // none for a deleted base edge
+    Index slots(Index w) const
+    {
+        return ((Index)(_rp[w+1] - _rp[w]) + (Index)_delta[w].size());
+    }
+
+    Index neighbor(Index w, Index i) const
+    {
+        Index nbase = (Index)(_rp[w+1] - _rp[w]);
+        if (i < nbase)
+        {
+            NzSizeType p = _rp[w] + i;
+            return (_alive[p] ? _cols[p] : none());
+        }
+        return (_delta[w][i - nbase]);
+    }
+
+    // 1 if the edge is in the base at p, 2 if it is in the delta at q
+    int find_edge(Index u, Index v, NzSizeType& p, std::size_t& q) const
+    {
+        if (slots(u) > slots(v)) { std::swap(u, v); }
+        for (p = _rp[u]; p < _rp[u+1]; ++p)
+        {
+            if (_alive[p] && _cols[p] == v) { return (1); }
+        }
+        for (q = 0; q < _delta[u].size(); ++q)
+        {
+            if (_delta[u][q] == v) { return (2); }
+        }
+        return (0);
+    }
+
+    void unlink(Index u, Index v)
+    {
+        for (NzSizeType p = _rp[u]; p < _rp[u+1]; ++p)
+        {
+            if (_alive[p] && _cols[p] == v) { _alive[p] = 0; ++_ndead; return; }
+        }
+        std::vector<Index>& d = _delta[u];
+        for (std::size_t q = 0; q < d.size(); ++q)
+        {
+            if (d[q] == v) { d[q] = d.back(); d.pop_back(); --_ndelta; return; }
+        }
+    }
+
+    void maybe_compact()
+    {
+        if (2*(_ndead + _ndelta) > _cols.size() + 1024) { compact(); }
+    }
+
+    void count_core(Index k, int change)
+    {
+        if ((std::size_t)k >= _count.size()) { _count.resize(k+1, 0); }
+        _count[k] += change;
+        while (!_count.empty() && _count.back() == 0) { _count.pop_back(); }
+    }
+
+    void set_core(Index w, Index k)
+    {
+        count_core(_core[w], -1);
+        _core[w] = k;
+        count_core(k, 1);
+    }
+
+    // the number of neighbors of w with core >= k
+    Index core_degree(Index w, Index k) const
+    {
+        Index cd = 0;
+        for (Index i=0, ns = slots(w); i < ns; ++i)
+        {
+            Index x = neighbor(w, i);
+            if (x != none() && _core[x] >= k) { ++cd; }
+        }
+        return (cd);
+    }
+
+    void clear_marks()
+    {
+        for (std::size_t i=0; i < _touched.size(); ++i) { _mark[_touched[i]] = 0; }
+        _visited += _touched.size();
+        _touched.clear();
+    }
+
+    // marks for insert_update
+    enum { unvisited = 0, candidate = 1, evicted = 2 };
+
+    void insert_update(Index root, Index k)
+    {
+        // find the candidates
+        _stack.clear();
+        _stack.push_back(root);
+        _mark[root] = candidate;
+        _touched.push_back(root);
+        _evict.clear();
+        while (!_stack.empty())
+        {
+            Index w = _stack.back();
+            _stack.pop_back();
+            _cd[w] = core_degree(w, k);
+            if (_cd[w] <= k) { _mark[w] = evicted; _evict.push_back(w); continue; }
+            for (Index i=0, ns = slots(w); i < ns; ++i)
+            {
+                Index x = neighbor(w, i);
+                if (x == none() || _core[x] != k || _mark[x] != unvisited) { continue; }
+                _mark[x] = candidate;
+                _touched.push_back(x);
+                _stack.push_back(x);
+            }
+        }
+
+        // evict the candidates without enough support
+        while (!_evict.empty())
+        {
+            Index w = _evict.back();
+            _evict.pop_back();
+            for (Index i=0, ns = slots(w); i < ns; ++i)
+            {
+                Index x = neighbor(w, i);
+                if (x == none() || _core[x] != k || _mark[x] != candidate) { continue; }
+                if (--_cd[x] <= k) { _mark[x] = evicted; _evict.push_back(x); }
+            }
+        }
+
+        for (std::size_t i=0; i < _touched.size(); ++i)
+        {
+            Index w = _touched[i];
+            if (_mark[w] == candidate) { set_core(w, k+1); }
+        }
+        clear_marks();
+    }
+
+    // mark a vertex of core k for remove_update, computing its core degree
+    void remove_visit(Index w, Index k)
+    {
+        _mark[w] = candidate;
+        _touched.push_back(w);
+        _cd[w] = core_degree(w, k);
+        if (_cd[w] < k) { _mark[w] = evicted; _evict.push_back(w); }
+    }
+
+    void remove_update(Index u, Index v, Index k)
+    {
+        _evict.clear();
+        if (_core[u] == k) { remove_visit(u, k); }
+        if (_core[v] == k && _mark[v] == unvisited) { remove_visit(v, k); }
+
+        while (!_evict.empty())
+        {
+            Index w = _evict.back();
+            _evict.pop_back();
+            set_core(w, k-1);
+            for (Index i=0, ns = slots(w); i < ns; ++i)
+            {
+                Index x = neighbor(w, i);
+                if (x == none() || _core[x] != k) { continue; }
+                if (_mark[x] == unvisited)
+                {
+                    // w already has core k-1, so it is not counted
+                    remove_visit(x, k);
+                }
+                else if (_mark[x] == candidate && --_cd[x] < k)
+                {
+                    _mark[x] = evicted;
+                    _evict.push_back(x);
+                }
+            }
+        }
+        clear_marks();
+    }
+
+    Index _n;
+
+    // the base graph, its deleted edges, and the inserted edges
+    std::vector<NzSizeType> _rp;
+    std::vector<Index> _cols;
+    std::vector<char> _alive;
+    std::size_t _ndead;
+    std::vector< std::vector<Index> > _delta;
+    std::size_t _ndelta;
+
+    std::vector<Index> _core;
+    std::vector<std::size_t> _count;
+
+    // the scratch space for the updates
+    std::vector<char> _mark;
+    std::vector<Index> _cd;
+    std::vector<Index> _touched;
+    std::vector<Index> _stack;
+    std::vector<Index> _evict;
+    std::size_t _visited;
+};
+
+} // namespace yasmic
+
+#endif // YASMIC_DYNAMIC_CORE_NUMBERS_HPP
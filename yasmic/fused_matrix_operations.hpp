@@ -0,0 +1,364 @@
+#ifndef YASMIC_FUSED_MATRIX_OPERATIONS_HPP
+#define YASMIC_FUSED_MATRIX_OPERATIONS_HPP
+
+/**
+ * @file fused_matrix_operations.hpp
+ * Matrix-vector products fused with the vector updates that usually
+ * follow them, so that the vectors are only streamed from memory once.
+ *
+ *   mult_axpby_nrm2  y = alpha*A*x + beta*y, return ||y||_2
+ *   mult_axpby_nrm1  y = alpha*A*x + beta*y, return ||y||_1
+ *   mult_axpby_dot   y = alpha*A*x + beta*y, return dot(y,w)
+ *   normal_mult      y = A^T*(A*x) without forming A*x
+ *
+ * The axpby products split the rows among threads as parallel_mult
+ * does, and the partial sums of the norm or dot product are added in
+ * thread order, so the result only depends on the number of threads.
+ * When beta is zero, y is not read.
+ *
+ * normal_mult computes t = A(i,:)*x for each row and immediately
+ * scatters t*A(i,:)' into y, so each row is read once while it is in
+ * cache.  With more than one thread the scatter goes into private
+ * accumulators from a parallel_trans_mult_workspace.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/parallel_matrix_operations.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    struct axpby_sum_squares
+    {
+        template <class Value, class Index>
+        Value operator()(Value yr, Index) const { return (yr*yr); }
+    };
+
+    struct axpby_sum_abs
+    {
+        template <class Value, class Index>
+        Value operator()(Value yr, Index) const { return (yr < Value() ? -yr : yr); }
+    };
+
+    template <class Iter>
+    struct axpby_dot_with
+    {
+        Iter w;
+        axpby_dot_with(Iter w) : w(w) {}
+        template <class Value, class Index>
+        Value operator()(Value yr, Index r) const { return (yr*w[r]); }
+    };
+
+    /**
+     * y[r] = alpha*A(r,:)*x + beta*y[r] for the rows in [rstart, rend),
+     * return the sum of f(y[r], r).
+     */
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2, class Reduce>
+    Value csr_axpby_rows(RowIter ri, ColIter ci, ValIter vi,
+        Index rstart, Index rend, Value alpha, Iter1 x, Value beta, Iter2 y,
+        const Reduce& f)
+    {
+        typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+
+        Value sum = Value();
+        for (Index r=rstart; r < rend; ++r)
+        {
+            Value ip = Value();
+            for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                ip += vi[cp]*x[ci[cp]];
+            }
+            Value yr = alpha*ip;
+            if (beta != Value()) { yr += beta*y[r]; }
+            y[r] = yr;
+            sum += f(yr, r);
+        }
+        return (sum);
+    }
+
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2, class Reduce>
+    Value parallel_csr_axpby(RowIter ri, ColIter ci, ValIter vi, Index nr,
+        Value alpha, Iter1 x, Value beta, Iter2 y, const Reduce& f,
+        int nthreads)
+    {
+        if (nthreads < 1) { nthreads = 1; }
+        if (nthreads == 1)
+        {
+            return (csr_axpby_rows(ri, ci, vi, (Index)0, nr,
+                alpha, x, beta, y, f));
+        }
+
+        std::vector<Index> part(nthreads+1);
+        nnz_balanced_row_partition(ri, nr, nthreads, part.begin());
+        std::vector<Value> partial(nthreads);
+
+        #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+        for (int p=0; p < nthreads; ++p)
+        {
+            partial[p] = csr_axpby_rows(ri, ci, vi, part[p], part[p+1],
+                alpha, x, beta, y, f);
+        }
+
+        Value sum = Value();
+        for (int p=0; p < nthreads; ++p) { sum += partial[p]; }
+        return (sum);
+    }
+
+    /**
+     * y += A(rstart:rend,:)^T*(A(rstart:rend,:)*x)
+     */
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2>
+    void csr_normal_mult_rows(RowIter ri, ColIter ci, ValIter vi,
+        Index rstart, Index rend, Iter1 x, Iter2 y)
+    {
+        typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+
+        for (Index r=rstart; r < rend; ++r)
+        {
+            Value t = Value();
+            for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                t += vi[cp]*x[ci[cp]];
+            }
+            for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                y[ci[cp]] += vi[cp]*t;
+            }
+        }
+    }
+
+    template <class RowIter, class ColIter, class ValIter, class Index,
+        class Iter1, class Iter2, class Workspace>
+    void parallel_csr_normal_mult(RowIter ri, ColIter ci, ValIter vi,
+        Index nr, Index nc, Iter1 x, Iter2 y, Workspace& w)
+    {
+        typedef typename std::iterator_traits<ValIter>::value_type vtype;
+
+        int nthreads = w.nthreads;
+        std::size_t acc_bytes =
+            (std::size_t)nthreads*(std::size_t)nc*sizeof(vtype);
+
+        if (nthreads <= 1 || acc_bytes > w.memory_budget)
+        {
+            for (Index c=0; c < nc; ++c) { y[c] = vtype(); }
+            csr_normal_mult_rows<vtype>(ri, ci, vi, (Index)0, nr, x, y);
+            return;
+        }
+
+        w.acc.resize((std::size_t)nthreads*(std::size_t)nc);
+
+        std::vector<Index> part(nthreads+1);
+        nnz_balanced_row_partition(ri, nr, nthreads, part.begin());
+
+        #pragma omp parallel num_threads(nthreads)
+        {
+            #pragma omp for schedule(static,1)
+            for (int p=0; p < nthreads; ++p)
+            {
+                vtype *acc = &w.acc[(std::size_t)p*(std::size_t)nc];
+                for (Index c=0; c < nc; ++c) { acc[c] = vtype(); }
+                csr_normal_mult_rows<vtype>(ri, ci, vi, part[p], part[p+1],
+                    x, acc);
+            }
+
+            // reduce the accumulators in a fixed order
+            #pragma omp for schedule(static)
+            for (Index c=0; c < nc; ++c)
+            {
+                vtype sum = vtype();
+                for (int p=0; p < nthreads; ++p)
+                {
+                    sum += w.acc[(std::size_t)p*(std::size_t)nc + c];
+                }
+                y[c] = sum;
+            }
+        }
+    }
+} // namespace impl
+
+/**
+ * Compute y = alpha*A*x + beta*y and return ||y||_2 for a
+ * simple_csr_matrix.
+ *
+ * @param m the matrix A
+ * @param alpha the scale of A*x
+ * @param x the input vector, size ncols(m)
+ * @param beta the scale of y, if zero y is not read
+ * @param y the input and output vector, size nrows(m)
+ * @param nthreads the number of threads
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+ValueType mult_axpby_nrm2(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    ValueType alpha, Iter1 x, ValueType beta, Iter2 y,
+    int nthreads=parallel_max_threads())
+{
+    return (std::sqrt(impl::parallel_csr_axpby((const NzSizeType*)m.ai,
+        (const IndexType*)m.aj, (const ValueType*)m.a, m.nrows,
+        alpha, x, beta, y, impl::axpby_sum_squares(), nthreads)));
+}
+
+/**
+ * Compute y = alpha*A*x + beta*y and return ||y||_1 for a
+ * simple_csr_matrix.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+ValueType mult_axpby_nrm1(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    ValueType alpha, Iter1 x, ValueType beta, Iter2 y,
+    int nthreads=parallel_max_threads())
+{
+    return (impl::parallel_csr_axpby((const NzSizeType*)m.ai,
+        (const IndexType*)m.aj, (const ValueType*)m.a, m.nrows,
+        alpha, x, beta, y, impl::axpby_sum_abs(), nthreads));
+}
+
+/**
+ * Compute y = alpha*A*x + beta*y and return dot(y,w) for a
+ * simple_csr_matrix.
+ *
+ * @param w the vector for the dot product, size nrows(m)
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2, class Iter3>
+ValueType mult_axpby_dot(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    ValueType alpha, Iter1 x, ValueType beta, Iter2 y, Iter3 w,
+    int nthreads=parallel_max_threads())
+{
+    return (impl::parallel_csr_axpby((const NzSizeType*)m.ai,
+        (const IndexType*)m.aj, (const ValueType*)m.a, m.nrows,
+        alpha, x, beta, y, impl::axpby_dot_with<Iter3>(w), nthreads));
+}
+
+/**
+ * Compute y = alpha*A*x + beta*y and return ||y||_2 for a
+ * compressed_row_matrix.  RowIter must be a random access iterator.
+ */
+template <class RowIter, class ColIter, class ValIter, class Iter1, class Iter2>
+typename std::iterator_traits<ValIter>::value_type mult_axpby_nrm2(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    typename std::iterator_traits<ValIter>::value_type alpha, Iter1 x,
+    typename std::iterator_traits<ValIter>::value_type beta, Iter2 y,
+    int nthreads=parallel_max_threads())
+{
+    typename std::iterator_traits<RowIter>::value_type nr = nrows(m);
+    return (std::sqrt(impl::parallel_csr_axpby(m._rstart, m._cstart,
+        m._vstart, nr, alpha, x, beta, y, impl::axpby_sum_squares(),
+        nthreads)));
+}
+
+/**
+ * Compute y = alpha*A*x + beta*y and return ||y||_1 for a
+ * compressed_row_matrix.  RowIter must be a random access iterator.
+ */
+template <class RowIter, class ColIter, class ValIter, class Iter1, class Iter2>
+typename std::iterator_traits<ValIter>::value_type mult_axpby_nrm1(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    typename std::iterator_traits<ValIter>::value_type alpha, Iter1 x,
+    typename std::iterator_traits<ValIter>::value_type beta, Iter2 y,
+    int nthreads=parallel_max_threads())
+{
+    typename std::iterator_traits<RowIter>::value_type nr = nrows(m);
+    return (impl::parallel_csr_axpby(m._rstart, m._cstart, m._vstart, nr,
+        alpha, x, beta, y, impl::axpby_sum_abs(), nthreads));
+}
+
+/**
+ * Compute y = alpha*A*x + beta*y and return dot(y,w) for a
+ * compressed_row_matrix.  RowIter must be a random access iterator.
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class Iter1, class Iter2, class Iter3>
+typename std::iterator_traits<ValIter>::value_type mult_axpby_dot(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    typename std::iterator_traits<ValIter>::value_type alpha, Iter1 x,
+    typename std::iterator_traits<ValIter>::value_type beta, Iter2 y, Iter3 w,
+    int nthreads=parallel_max_threads())
+{
+    typename std::iterator_traits<RowIter>::value_type nr = nrows(m);
+    return (impl::parallel_csr_axpby(m._rstart, m._cstart, m._vstart, nr,
+        alpha, x, beta, y, impl::axpby_dot_with<Iter3>(w), nthreads));
+}
+
+/**
+ * Compute y = A^T*(A*x) in one pass over a simple_csr_matrix.
+ *
+ * @param m the matrix A
+ * @param x the input vector, size ncols(m)
+ * @param y the output vector, size ncols(m)
+ * @param w the workspace, only its thread count, memory budget and
+ *   accumulators are used
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void normal_mult(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y,
+    parallel_trans_mult_workspace<IndexType, ValueType, NzSizeType>& w)
+{
+    impl::parallel_csr_normal_mult((const NzSizeType*)m.ai,
+        (const IndexType*)m.aj, (const ValueType*)m.a, m.nrows, m.ncols,
+        x, y, w);
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void normal_mult(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_trans_mult_workspace<IndexType, ValueType, NzSizeType> w;
+    normal_mult(m, x, y, w);
+}
+
+/**
+ * Compute y = A^T*(A*x) in one pass over a compressed_row_matrix.
+ * RowIter must be a random access iterator.
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class Iter1, class Iter2, class Workspace>
+void normal_mult(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, Workspace& w)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+
+    itype nr = nrows(m);
+    itype nc = ncols(m);
+
+    impl::parallel_csr_normal_mult(m._rstart, m._cstart, m._vstart,
+        nr, nc, x, y, w);
+}
+
+template <class RowIter, class ColIter, class ValIter, class Iter1, class Iter2>
+void normal_mult(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+    typedef typename smatrix_traits<matrix>::value_type vtype;
+
+    parallel_trans_mult_workspace<itype, vtype> w;
+    normal_mult(m, x, y, w);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_FUSED_MATRIX_OPERATIONS_HPP
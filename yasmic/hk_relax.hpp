@@ -0,0 +1,241 @@
+#ifndef YASMIC_HK_RELAX_HPP
+#define YASMIC_HK_RELAX_HPP
+
+/**
+ * @file hk_relax.hpp
+ * Approximate heat kernel diffusion with hk-relax over an undirected
+ * graph in a simple_csr_matrix.
+ *
+ * The heat kernel vector of a seed set s is
+ *
+ *   h = exp(-t*(I - P))*s = exp(-t) sum_k t^k/k! P^k s,  P = A*D^{-1}.
+ *
+ * The series is truncated after N terms, with N the smallest degree
+ * where the tail exp(-t) sum_{k>N} t^k/k! is below eps/2.  There is a
+ * residual vector r_j for each term j.  A push of vertex v in term j
+ * moves r_j(v) to x(v) and adds t/(j+1)*r_j(v)/d(v) to r_{j+1}(u) for
+ * each neighbor u.  Only the entries with
+ *
+ *   r_j(v) >= exp(t)*eps*d(v)/(2*N*psi_j(t)),
+ *   psi_j(t) = sum_{m=0}^{N-j} j!/(m+j)! t^m,
+ *
+ * are pushed, and the last term is added to x directly.  Pushes only
+ * go from term j to j+1, so the terms are done in order and each r_j is
+ * its own queue; each (v,j) is pushed at most once.  The result x is
+ * scaled by exp(-t) and has ||D^{-1}(h - x)||_inf < eps.  The work
+ * depends on t and eps but not on the size of the graph.
+ *
+ * The degrees are the number of neighbors and the edge values are not
+ * used.  The residuals and the solution are sparse_maps kept in a
+ * hk_relax_workspace, which is the arena that is reused across seeds;
+ * its maps keep their memory over clear.  The output is a
+ * sparse_vector, so sweep_cut applies as it does for ppr_push.
+ *
+ * K. Kloster and D. F. Gleich, "Heat kernel based community detection,"
+ * KDD 2014.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/sparse_map.hpp>
+#include <yasmic/semiring_operations.hpp>
+
+namespace yasmic
+{
+
+/**
+ * The state for hk_relax, keep it between the calls for many seeds.
+ */
+template <class Index, class Value>
+struct hk_relax_workspace
+{
+    sparse_map<Index, Value> x;
+
+    // the residual of each term, only grown, never shrunk
+    std::vector< sparse_map<Index, Value> > r;
+
+    // the thresholds exp(t)*eps/(2*N*psi_j) for the last t and eps
+    std::vector<Value> pushcoeff;
+
+    // the number of terms, pushes and work (the sum of the degrees of
+    // the pushed vertices) of the last call
+    int nterms;
+    std::size_t npushes;
+    std::size_t work;
+
+    hk_relax_workspace() : nterms(0), npushes(0), work(0) {}
+};
+
+/**
+ * The smallest N where exp(-t) sum_{k>N} t^k/k! < eps/2.
+ */
+template <class Value>
+int hk_relax_terms(Value t, Value eps)
+{
+    Value tail = Value(1) - std::exp(-t);
+    Value term = std::exp(-t);
+    int n = 0;
+    while (tail >= eps/Value(2) && n < 1000)
+    {
+        ++n;
+        term *= t/(Value)n;
+        tail -= term;
+    }
+    return (n < 1 ? 1 : n);
+}
+
+/**
+ * Compute an approximate heat kernel vector for a seed set.
+ *
+ * @param g the undirected graph, g.ai and g.aj are used
+ * @param first the first seed
+ * @param last the end of the seeds, the mass starts uniform over them
+ * @param t the diffusion time
+ * @param eps the tolerance, ||D^{-1}(h - x)||_inf < eps
+ * @param y the output, the nonzeros of x in the order they were found
+ * @param w the workspace
+ * @return the number of pushes
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class SeedIter, class Value>
+std::size_t hk_relax(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    SeedIter first, SeedIter last, Value t, Value eps,
+    sparse_vector<IndexType, Value>& y,
+    hk_relax_workspace<IndexType, Value>& w)
+{
+    const NzSizeType *ai = g.ai;
+    const IndexType *aj = g.aj;
+
+    int n = hk_relax_terms(t, eps);
+    w.nterms = n;
+    w.npushes = 0;
+    w.work = 0;
+    w.x.clear();
+    if ((int)w.r.size() < n+1) { w.r.resize(n+1); }
+    for (int j=0; j <= n; ++j) { w.r[j].clear(); }
+    y.clear();
+
+    // psi_N = 1, psi_j = 1 + t/(j+1)*psi_{j+1}
+    w.pushcoeff.resize(n+1);
+    Value psi = Value(1);
+    for (int j=n; j >= 0; --j)
+    {
+        if (j < n) { psi = Value(1) + t/(Value)(j+1)*psi; }
+        w.pushcoeff[j] = std::exp(t)*eps/(Value(2)*(Value)n*psi);
+    }
+
+    std::size_t nseeds = 0;
+    for (SeedIter si = first; si != last; ++si) { ++nseeds; }
+    if (nseeds == 0) { return (0); }
+    for (SeedIter si = first; si != last; ++si)
+    {
+        w.r[0][*si] += Value(1)/(Value)nseeds;
+    }
+
+    for (int j=0; j < n; ++j)
+    {
+        sparse_map<IndexType, Value>& rj = w.r[j];
+        sparse_map<IndexType, Value>& rnext = w.r[j+1];
+        Value coeff = w.pushcoeff[j];
+        Value tj = t/(Value)(j+1);
+
+        for (std::size_t i=0; i < rj.size(); ++i)
+        {
+            IndexType v = rj.key(i);
+            Value rv = rj.value(i);
+            NzSizeType dv = ai[v+1] - ai[v];
+            if (rv < coeff*(Value)dv) { continue; }
+
+            rj.value(i) = Value();
+            ++w.npushes;
+            w.work += dv;
+            w.x[v] += rv;
+
+            // a vertex without neighbors keeps the rest of the series
+            if (dv == 0) { continue; }
+
+            Value mass = tj*rv/(Value)dv;
+            for (NzSizeType k = ai[v]; k < ai[v+1]; ++k)
+            {
+                rnext[aj[k]] += mass;
+            }
+        }
+    }
+
+    // the last term goes to x without pushing
+    sparse_map<IndexType, Value>& rn = w.r[n];
+    for (std::size_t i=0; i < rn.size(); ++i)
+    {
+        w.x[rn.key(i)] += rn.value(i);
+    }
+
+    Value scale = std::exp(-t);
+    for (std::size_t i=0; i < w.x.size(); ++i)
+    {
+        y.push_back(w.x.key(i), scale*w.x.value(i));
+    }
+    return (w.npushes);
+}
+
+/**
+ * Compute an approximate heat kernel vector for one seed.
+ */
+template <class IndexType, class ValueType, class NzSizeType, class Value>
+std::size_t hk_relax(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    IndexType seed, Value t, Value eps,
+    sparse_vector<IndexType, Value>& y,
+    hk_relax_workspace<IndexType, Value>& w)
+{
+    return (hk_relax(g, &seed, &seed + 1, t, eps, y, w));
+}
+
+/**
+ * Compute an approximate heat kernel vector for each seed in a list.
+ * The seeds are split dynamically among threads, each with its own
+ * workspace.
+ *
+ * @param ys the outputs, ys[i] is the vector for seed first[i]
+ * @return the total number of pushes
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class SeedIter, class Value>
+std::size_t hk_relax_batch(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    SeedIter first, SeedIter last, Value t, Value eps,
+    std::vector< sparse_vector<IndexType, Value> >& ys,
+    int nthreads=parallel_max_threads())
+{
+    std::vector<IndexType> seeds(first, last);
+    int nseeds = (int)seeds.size();
+    ys.resize(nseeds);
+
+    if (nthreads < 1) { nthreads = 1; }
+    if (nthreads > nseeds) { nthreads = nseeds > 0 ? nseeds : 1; }
+
+    std::vector< hk_relax_workspace<IndexType, Value> > ws(nthreads);
+    std::vector<std::size_t> pushes(nthreads, 0);
+
+    #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads)
+    for (int i=0; i < nseeds; ++i)
+    {
+        int tid = parallel_thread_num();
+        pushes[tid] += hk_relax(g, seeds[i], t, eps, ys[i], ws[tid]);
+    }
+
+    std::size_t total = 0;
+    for (int tid=0; tid < nthreads; ++tid) { total += pushes[tid]; }
+    return (total);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_HK_RELAX_HPP
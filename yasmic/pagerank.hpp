@@ -0,0 +1,438 @@
+#ifndef YASMIC_PAGERANK_HPP
+#define YASMIC_PAGERANK_HPP
+
+/**
+ * @file pagerank.hpp
+ * PageRank with the power method or Gauss-Seidel over a compressed row
+ * matrix of in-links.
+ *
+ * Row i of the matrix holds the in-links of page i, so m(i,j) is the
+ * weight of the link j -> i.  This is the compressed column form of the
+ * usual adjacency matrix A; build it with a transpose.  The iteration
+ * uses the column stochastic P' = (D^{-1}A)' without forming it: the
+ * inverse out-degrees D^{-1} (the column sums of m) are computed once,
+ * and the iterate is kept both as x and as xd = D^{-1}x, so each row is
+ * a plain dot product with xd.
+ *
+ * A dangling page, one without out-links, links to the pages in the
+ * personalization vector v.  The power method computes
+ *
+ *   y = alpha*P'*x + (1 - alpha*(sum(x) - sum(x(dangling))))*v
+ *
+ * which keeps sum(y) = 1 without a separate pass.  The update, the L1
+ * residual ||y - x||_1 and the dangling mass of y are fused into one
+ * sweep that is split among threads as parallel_mult is.
+ *
+ * The options can select
+ *   - gauss_seidel: x is updated in place in row order.  This usually
+ *     takes about half the iterations but is serial.
+ *   - extrapolate_every = d: every d power iterations apply the power
+ *     extrapolation x_k = (x_k - alpha^d*x_{k-d})/(1 - alpha^d), which
+ *     removes the components along the eigenvalues alpha*w with w^d = 1.
+ *     A graph with cycles has such eigenvalues.  Use d >= 6, the
+ *     extrapolation with small d can amplify the other components.  See
+ *     Haveliwala, Kamvar, Klein, Manning, and Golub, "Computing PageRank
+ *     using power extrapolation," Stanford tech. report, 2003.
+ *
+ * A callback is called after each iteration with the iteration number,
+ * the residual, and the time of the iteration in seconds.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+struct pagerank_options
+{
+    enum method_type
+    {
+        power_method,
+        gauss_seidel
+    };
+
+    // the teleportation parameter
+    double alpha;
+
+    // stop when ||x_{k+1} - x_k||_1 < tol, or after maxiter iterations
+    double tol;
+    int maxiter;
+
+    method_type method;
+
+    // extrapolate every so many power iterations, 0 for never, see above
+    int extrapolate_every;
+
+    // the number of threads for the power method
+    int nthreads;
+
+    pagerank_options()
+    : alpha(0.85), tol(1e-8), maxiter(1000), method(power_method),
+      extrapolate_every(0), nthreads(parallel_max_threads()) {}
+};
+
+/**
+ * The default pagerank callback, it does nothing.
+ */
+struct pagerank_no_callback
+{
+    template <class Value>
+    void operator()(int, Value, double) const {}
+};
+
+/**
+ * Record the residual and the time of each iteration.
+ */
+template <class Value>
+struct pagerank_history_callback
+{
+    std::vector<Value>& residuals;
+    std::vector<double>& times;
+
+    pagerank_history_callback(std::vector<Value>& r, std::vector<double>& t)
+    : residuals(r), times(t) {}
+
+    void operator()(int, Value resid, double dt) const
+    {
+        residuals.push_back(resid);
+        times.push_back(dt);
+    }
+};
+
+namespace impl
+{
+    template <class Value>
+    struct pagerank_uniform
+    {
+        Value vi;
+        pagerank_uniform(Value vi) : vi(vi) {}
+        template <class Index>
+        Value operator[](Index) const { return (vi); }
+    };
+
+    /**
+     * Set invd to one over the column sums of m, or zero for an empty
+     * column (a dangling page).
+     */
+    template <class RowIter, class ColIter, class ValIter, class Index,
+        class Value>
+    void pagerank_inverse_degrees(RowIter ri, ColIter ci, ValIter vi,
+        Index n, std::vector<Value>& invd)
+    {
+        invd.assign(n, Value());
+        for (typename std::iterator_traits<RowIter>::value_type
+             cp = ri[0]; cp < ri[n]; ++cp)
+        {
+            invd[ci[cp]] += (Value)vi[cp];
+        }
+        for (Index j=0; j < n; ++j)
+        {
+            if (invd[j] != Value()) { invd[j] = Value(1)/invd[j]; }
+        }
+    }
+
+    template <class Value>
+    struct pagerank_sweep
+    {
+        Value resid;
+        Value dangling;
+        Value sum;
+        pagerank_sweep() : resid(), dangling(), sum() {}
+    };
+
+    /**
+     * One power iteration over the rows in [rstart, rend).  If extrap
+     * is not zero, y is extrapolated with xold, the iterate from d
+     * steps ago, and xold is set to the result.
+     */
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class VIter>
+    pagerank_sweep<Value> pagerank_power_rows(RowIter ri, ColIter ci,
+        ValIter vi, Index rstart, Index rend,
+        const Value* x, const Value* xd, Value* y, Value* yd, Value* xold,
+        const Value* invd, VIter v, Value alpha, Value gamma, Value extrap)
+    {
+        typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+
+        pagerank_sweep<Value> s;
+        for (Index r=rstart; r < rend; ++r)
+        {
+            Value ip = Value();
+            for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                ip += (Value)vi[cp]*xd[ci[cp]];
+            }
+            Value yr = alpha*ip + gamma*v[r];
+            Value dr = yr - x[r];
+            s.resid += dr < Value() ? -dr : dr;
+            if (extrap != Value())
+            {
+                yr = (yr - extrap*xold[r])/(Value(1) - extrap);
+                xold[r] = yr;
+            }
+            y[r] = yr;
+            yd[r] = yr*invd[r];
+            if (invd[r] == Value()) { s.dangling += yr; }
+            s.sum += yr;
+        }
+        return (s);
+    }
+
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class VIter>
+    pagerank_sweep<Value> parallel_pagerank_power(RowIter ri, ColIter ci,
+        ValIter vi, Index n, const std::vector<Index>& part,
+        const Value* x, const Value* xd, Value* y, Value* yd, Value* xold,
+        const Value* invd, VIter v, Value alpha, Value gamma, Value extrap)
+    {
+        int nthreads = (int)part.size() - 1;
+        if (nthreads == 1)
+        {
+            return (pagerank_power_rows(ri, ci, vi, (Index)0, n,
+                x, xd, y, yd, xold, invd, v, alpha, gamma, extrap));
+        }
+
+        std::vector< pagerank_sweep<Value> > partial(nthreads);
+
+        #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+        for (int p=0; p < nthreads; ++p)
+        {
+            partial[p] = pagerank_power_rows(ri, ci, vi, part[p], part[p+1],
+                x, xd, y, yd, xold, invd, v, alpha, gamma, extrap);
+        }
+
+        // add the partial sums in a fixed order
+        pagerank_sweep<Value> s;
+        for (int p=0; p < nthreads; ++p)
+        {
+            s.resid += partial[p].resid;
+            s.dangling += partial[p].dangling;
+            s.sum += partial[p].sum;
+        }
+        return (s);
+    }
+
+    /**
+     * One Gauss-Seidel sweep, x and xd are updated in place.  The
+     * dangling mass and the sum of x are kept up to date during the
+     * sweep, and a self loop m(r,r) is solved for.
+     */
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class VIter>
+    Value pagerank_gauss_seidel_sweep(RowIter ri, ColIter ci, ValIter vi,
+        Index n, Value* x, Value* xd, const Value* invd, VIter v, Value alpha,
+        Value& dangling, Value& sum)
+    {
+        typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+
+        Value resid = Value();
+        for (Index r=0; r < n; ++r)
+        {
+            Value ip = Value(), diag = Value();
+            for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                if ((Index)ci[cp] == r) { diag += (Value)vi[cp]*invd[r]; }
+                else { ip += (Value)vi[cp]*xd[ci[cp]]; }
+            }
+            Value gamma = alpha*dangling + (Value(1) - alpha)*sum;
+            Value xr = (alpha*ip + gamma*v[r])/(Value(1) - alpha*diag);
+            Value dr = xr - x[r];
+            resid += dr < Value() ? -dr : dr;
+            if (invd[r] == Value()) { dangling += dr; }
+            sum += dr;
+            x[r] = xr;
+            xd[r] = xr*invd[r];
+        }
+        return (resid);
+    }
+
+    template <class RowIter, class ColIter, class ValIter, class Index,
+        class Iter, class VIter, class Callback>
+    int pagerank(RowIter ri, ColIter ci, ValIter vi, Index n,
+        Iter xout, VIter v, const pagerank_options& opts, Callback cb)
+    {
+        typedef typename std::iterator_traits<Iter>::value_type Value;
+
+        if (n == 0) { return (0); }
+
+        Value alpha = (Value)opts.alpha;
+        std::vector<Value> invd;
+        pagerank_inverse_degrees(ri, ci, vi, n, invd);
+
+        // start from v
+        std::vector<Value> x(n), xd(n), y(n), yd(n);
+        Value dangling = Value(), sum = Value();
+        for (Index r=0; r < n; ++r)
+        {
+            x[r] = v[r];
+            xd[r] = x[r]*invd[r];
+            if (invd[r] == Value()) { dangling += x[r]; }
+            sum += x[r];
+        }
+
+        // the iterate from the last extrapolation, and alpha^d
+        std::vector<Value> xold;
+        Value alpha_d = Value(1);
+        if (opts.extrapolate_every > 0 &&
+            opts.method == pagerank_options::power_method)
+        {
+            xold = x;
+            for (int k=0; k < opts.extrapolate_every; ++k) { alpha_d *= alpha; }
+        }
+
+        int nthreads = opts.nthreads < 1 ? 1 : opts.nthreads;
+        std::vector<Index> part(nthreads+1);
+        nnz_balanced_row_partition(ri, n, nthreads, part.begin());
+
+        int iter = 0;
+        while (iter < opts.maxiter)
+        {
+            ++iter;
+            double t0 = parallel_wtime();
+            Value resid;
+
+            if (opts.method == pagerank_options::gauss_seidel)
+            {
+                resid = pagerank_gauss_seidel_sweep(ri, ci, vi, n,
+                    &x[0], &xd[0], &invd[0], v, alpha, dangling, sum);
+
+                // renormalize, the updates in place do not keep sum(x) = 1
+                if (sum != Value() && sum != Value(1))
+                {
+                    Value scale = Value(1)/sum;
+                    for (Index r=0; r < n; ++r) { x[r] *= scale; xd[r] *= scale; }
+                    dangling *= scale;
+                    sum = Value(1);
+                }
+            }
+            else
+            {
+                Value gamma = Value(1) - alpha*(sum - dangling);
+                Value extrap = Value();
+                if (opts.extrapolate_every > 0 &&
+                    iter % opts.extrapolate_every == 0)
+                {
+                    extrap = alpha_d;
+                }
+
+                pagerank_sweep<Value> s = parallel_pagerank_power(ri, ci, vi,
+                    n, part, &x[0], &xd[0], &y[0], &yd[0],
+                    xold.empty() ? 0 : &xold[0], &invd[0], v,
+                    alpha, gamma, extrap);
+                x.swap(y);
+                xd.swap(yd);
+                resid = s.resid;
+                dangling = s.dangling;
+                sum = s.sum;
+            }
+
+            cb(iter, resid, parallel_wtime() - t0);
+            if (resid < (Value)opts.tol) { break; }
+        }
+
+        std::copy(x.begin(), x.end(), xout);
+        return (iter);
+    }
+} // namespace impl
+
+/**
+ * Compute the PageRank vector of a simple_csr_matrix of in-links.
+ *
+ * @param m the in-link matrix, m(i,j) is the weight of the link j -> i
+ * @param x the output PageRank vector, size nrows(m)
+ * @param v the personalization vector, it should sum to 1
+ * @param opts the options
+ * @param cb a callback called as cb(iteration, residual, seconds)
+ * @return the number of iterations
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter, class VIter, class Callback>
+int pagerank(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter x, VIter v, const pagerank_options& opts, Callback cb)
+{
+    return (impl::pagerank((const NzSizeType*)m.ai, (const IndexType*)m.aj,
+        (const ValueType*)m.a, m.nrows, x, v, opts, cb));
+}
+
+/**
+ * Compute the PageRank vector of a simple_csr_matrix of in-links with
+ * a uniform personalization vector.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter, class Callback>
+int pagerank(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter x, const pagerank_options& opts, Callback cb)
+{
+    typedef typename std::iterator_traits<Iter>::value_type Value;
+    Value vi = m.nrows > 0 ? Value(1)/(Value)m.nrows : Value();
+    return (pagerank(m, x, impl::pagerank_uniform<Value>(vi), opts, cb));
+}
+
+template <class IndexType, class ValueType, class NzSizeType, class Iter>
+int pagerank(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter x, const pagerank_options& opts=pagerank_options())
+{
+    return (pagerank(m, x, opts, pagerank_no_callback()));
+}
+
+/**
+ * Compute the PageRank vector of a compressed_row_matrix of in-links.
+ * RowIter must be a random access iterator.
+ *
+ * @param m the in-link matrix, m(i,j) is the weight of the link j -> i
+ * @param x the output PageRank vector, size nrows(m)
+ * @param v the personalization vector, it should sum to 1
+ * @param opts the options
+ * @param cb a callback called as cb(iteration, residual, seconds)
+ * @return the number of iterations
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class Iter, class VIter, class Callback>
+int pagerank(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter x, VIter v, const pagerank_options& opts, Callback cb)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+
+    itype n = nrows(m);
+    return (impl::pagerank(m._rstart, m._cstart, m._vstart, n,
+        x, v, opts, cb));
+}
+
+/**
+ * Compute the PageRank vector of a compressed_row_matrix of in-links
+ * with a uniform personalization vector.
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class Iter, class Callback>
+int pagerank(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter x, const pagerank_options& opts, Callback cb)
+{
+    typedef typename std::iterator_traits<Iter>::value_type Value;
+    Value n = (Value)nrows(m);
+    Value vi = n > Value() ? Value(1)/n : Value();
+    return (pagerank(m, x, impl::pagerank_uniform<Value>(vi), opts, cb));
+}
+
+template <class RowIter, class ColIter, class ValIter, class Iter>
+int pagerank(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter x, const pagerank_options& opts=pagerank_options())
+{
+    return (pagerank(m, x, opts, pagerank_no_callback()));
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_PAGERANK_HPP
@@ -0,0 +1,293 @@
+#ifndef YASMIC_PARALLEL_BETWEENNESS_CENTRALITY_HPP
+#define YASMIC_PARALLEL_BETWEENNESS_CENTRALITY_HPP
+
+/**
+ * @file parallel_betweenness_centrality.hpp
+ * Brandes' betweenness centrality of a graph in a simple_csr_matrix,
+ * with the sources split over the threads.
+ *
+ * Each source s does a breadth first search, or a Dijkstra search on
+ * the edge values, that counts the shortest paths sigma(v) and records
+ * the vertices in the order they are settled.  Then the dependencies
+ *
+ *   delta(v) = sum_{w : d(w) = d(v) + w(v,w)} sigma(v)/sigma(w)*(1 + delta(w))
+ *
+ * are accumulated in reverse order.  The sum runs over the out edges of
+ * v, so the predecessors are never stored: an edge (v,w) is on a
+ * shortest path exactly when d(w) = d(v) + w(v,w), which is recomputed
+ * from the distances.  This keeps the state of a search in flat arrays
+ * of size n instead of a list of incoming edges for each vertex, and
+ * only the reached vertices are reset between sources.
+ *
+ * Each thread has its own search state and centrality array, and the
+ * centrality arrays are summed at the end.  The sources are handed out
+ * dynamically, so the results may differ from a serial run by rounding.
+ * The memory is O(n) for each thread.
+ *
+ * The graph is directed, as in boost::brandes_betweenness_centrality
+ * over simple_csr_matrix_as_graph.hpp, so the centrality of a symmetric
+ * graph counts each path in both directions; divide it by two for the
+ * undirected centrality.  The weights must be positive.
+ *
+ * U. Brandes, "A faster algorithm for betweenness centrality," Journal
+ * of Mathematical Sociology 25(2), 2001.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+/**
+ * The state of the shortest path search from one source, keep it
+ * between sources.  After betweenness_dependencies, order holds the
+ * reached vertices and delta(v) their dependencies.
+ */
+template <class Index, class Value>
+struct betweenness_workspace
+{
+    std::vector<Value> dist;
+    std::vector<double> sigma;
+    std::vector<double> delta;
+    std::vector<Index> order;
+
+    // the Dijkstra heap, with lazy deletion
+    std::vector< std::pair<Value, Index> > heap;
+
+    void resize(Index n)
+    {
+        if ((Index)dist.size() == n) { return; }
+        dist.assign(n, (std::numeric_limits<Value>::max)());
+        sigma.assign(n, 0.0);
+        delta.assign(n, 0.0);
+        order.clear();
+        order.reserve(n);
+    }
+};
+
+/**
+ * Compute the dependencies of all vertices on one source.
+ *
+ * @param g the graph
+ * @param s the source
+ * @param weighted use the values of g as edge weights, otherwise each
+ *   edge has length one
+ * @param w the workspace, the results are in w.order and w.delta
+ */
+template <class IndexType, class ValueType, class NzSizeType>
+void betweenness_dependencies(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    IndexType s, bool weighted,
+    betweenness_workspace<IndexType, ValueType>& w)
+{
+    const NzSizeType *ai = g.ai;
+    const IndexType *aj = g.aj;
+    const ValueType *a = g.a;
+    const ValueType inf = (std::numeric_limits<ValueType>::max)();
+
+    w.resize(g.nrows);
+
+    // reset the vertices from the last source
+    for (std::size_t i=0; i < w.order.size(); ++i)
+    {
+        IndexType v = w.order[i];
+        w.dist[v] = inf;
+        w.sigma[v] = 0.0;
+        w.delta[v] = 0.0;
+    }
+    w.order.clear();
+
+    w.dist[s] = ValueType(0);
+    w.sigma[s] = 1.0;
+
+    if (!weighted)
+    {
+        // the breadth first queue is the order
+        w.order.push_back(s);
+        for (std::size_t i=0; i < w.order.size(); ++i)
+        {
+            IndexType v = w.order[i];
+            ValueType dw = w.dist[v] + ValueType(1);
+            for (NzSizeType p = ai[v]; p < ai[v+1]; ++p)
+            {
+                IndexType u = aj[p];
+                if (w.dist[u] == inf)
+                {
+                    w.dist[u] = dw;
+                    w.order.push_back(u);
+                }
+                if (w.dist[u] == dw) { w.sigma[u] += w.sigma[v]; }
+            }
+        }
+    }
+    else
+    {
+        typedef std::pair<ValueType, IndexType> entry;
+        std::greater<entry> cmp;
+        w.heap.clear();
+        w.heap.push_back(entry(ValueType(0), s));
+        while (!w.heap.empty())
+        {
+            std::pop_heap(w.heap.begin(), w.heap.end(), cmp);
+            entry e = w.heap.back();
+            w.heap.pop_back();
+            IndexType v = e.second;
+            // each vertex has one entry at its final distance
+            if (e.first != w.dist[v]) { continue; }
+            w.order.push_back(v);
+            for (NzSizeType p = ai[v]; p < ai[v+1]; ++p)
+            {
+                IndexType u = aj[p];
+                ValueType du = w.dist[v] + a[p];
+                if (du < w.dist[u])
+                {
+                    w.dist[u] = du;
+                    w.sigma[u] = w.sigma[v];
+                    w.heap.push_back(entry(du, u));
+                    std::push_heap(w.heap.begin(), w.heap.end(), cmp);
+                }
+                else if (du == w.dist[u])
+                {
+                    w.sigma[u] += w.sigma[v];
+                }
+            }
+        }
+    }
+
+    // accumulate the dependencies over the shortest path successors
+    for (std::size_t i=w.order.size(); i-- > 0; )
+    {
+        IndexType v = w.order[i];
+        double dv = 0.0;
+        for (NzSizeType p = ai[v]; p < ai[v+1]; ++p)
+        {
+            IndexType u = aj[p];
+            ValueType len = weighted ? a[p] : ValueType(1);
+            if (w.dist[u] != inf && w.dist[u] == w.dist[v] + len)
+            {
+                dv += (1.0 + w.delta[u])/w.sigma[u];
+            }
+        }
+        w.delta[v] = w.sigma[v]*dv;
+    }
+}
+
+namespace impl
+{
+    /**
+     * Add the dependencies on a list of sources to sum, and their
+     * squares to sumsq if it is not null.  Each thread keeps its own
+     * sums, and they are added in at the end.
+     */
+    template <class IndexType, class ValueType, class NzSizeType>
+    void parallel_betweenness_sources(
+        const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+        const std::vector<IndexType>& sources, bool weighted,
+        std::vector<double>& sum, std::vector<double>* sumsq, int nthreads)
+    {
+        IndexType n = g.nrows;
+        int ns = (int)sources.size();
+
+        if (nthreads < 1) { nthreads = 1; }
+        if (nthreads > ns) { nthreads = ns > 0 ? ns : 1; }
+
+        std::vector< betweenness_workspace<IndexType, ValueType> > ws(nthreads);
+        std::vector< std::vector<double> > local(nthreads), localsq(nthreads);
+
+        #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads)
+        for (int i=0; i < ns; ++i)
+        {
+            int tid = parallel_thread_num();
+            betweenness_workspace<IndexType, ValueType>& w = ws[tid];
+            std::vector<double>& ct = local[tid];
+            std::vector<double>& cq = localsq[tid];
+            if (ct.empty()) { ct.assign(n, 0.0); }
+            if (sumsq && cq.empty()) { cq.assign(n, 0.0); }
+
+            IndexType s = sources[i];
+            betweenness_dependencies(g, s, weighted, w);
+            for (std::size_t k=1; k < w.order.size(); ++k)
+            {
+                IndexType v = w.order[k];
+                ct[v] += w.delta[v];
+                if (sumsq) { cq[v] += w.delta[v]*w.delta[v]; }
+            }
+        }
+
+        #pragma omp parallel for schedule(static) num_threads(nthreads)
+        for (IndexType v=0; v < n; ++v)
+        {
+            for (int t=0; t < nthreads; ++t)
+            {
+                if (!local[t].empty()) { sum[v] += local[t][v]; }
+                if (!localsq[t].empty()) { (*sumsq)[v] += localsq[t][v]; }
+            }
+        }
+    }
+
+    template <class IndexType, class ValueType, class NzSizeType,
+        class CentralityIter>
+    void parallel_betweenness_all_sources(
+        const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+        bool weighted, CentralityIter c, int nthreads)
+    {
+        IndexType n = g.nrows;
+        std::vector<IndexType> sources(n);
+        for (IndexType s=0; s < n; ++s) { sources[s] = s; }
+        std::vector<double> sum(n, 0.0);
+        parallel_betweenness_sources(g, sources, weighted, sum,
+            (std::vector<double>*)0, nthreads);
+        for (IndexType v=0; v < n; ++v) { c[v] = sum[v]; }
+    }
+} // namespace impl
+
+/**
+ * Compute the betweenness centrality with every edge of length one.
+ *
+ * @param g the graph
+ * @param c the output centrality, size nrows(g)
+ * @param nthreads the number of threads
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class CentralityIter>
+void parallel_betweenness_centrality(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    CentralityIter c, int nthreads=parallel_max_threads())
+{
+    impl::parallel_betweenness_all_sources(g, false, c, nthreads);
+}
+
+/**
+ * Compute the betweenness centrality with the values of g as the
+ * edge lengths.
+ *
+ * @param g the graph, with positive values
+ * @param c the output centrality, size nrows(g)
+ * @param nthreads the number of threads
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class CentralityIter>
+void parallel_weighted_betweenness_centrality(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    CentralityIter c, int nthreads=parallel_max_threads())
+{
+    impl::parallel_betweenness_all_sources(g, true, c, nthreads);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_PARALLEL_BETWEENNESS_CENTRALITY_HPP
@@ -0,0 +1,185 @@
+#ifndef YASMIC_PARALLEL_CORE_NUMBERS_HPP
+#define YASMIC_PARALLEL_CORE_NUMBERS_HPP
+
+/**
+ * @file parallel_core_numbers.hpp
+ * A parallel core decomposition of an undirected graph in a
+ * simple_csr_matrix, by level synchronous peeling.
+ *
+ * Level k starts with the vertices of smallest remaining degree k.  All
+ * the vertices of the frontier get core number k and are removed at
+ * once: the degree of each neighbor u with deg(u) > k is decremented
+ * atomically, and the thread that brings deg(u) to exactly k adds u to
+ * the next frontier.  A thread that takes deg(u) below k adds the one
+ * back, so deg(u) never drops under the current level and each vertex
+ * joins exactly one frontier.  When the frontier is empty the level is
+ * done and the next one starts at the new smallest degree.
+ *
+ * The core numbers are the same as boost::core_numbers from the
+ * Batagelj-Zaversnik algorithm in boost_mod/core_numbers.hpp, with the
+ * degree as the number of stored neighbors, so a self loop counts once.
+ * Each level scans the vertices that are left, and the removed vertices
+ * are compacted out during that scan.
+ *
+ * The method is the PKC algorithm of
+ * Kabir and Madduri, "Parallel k-core decomposition on multicore
+ * platforms," IPDPSW 2017.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    template <class T>
+    inline T atomic_read(const T& x)
+    {
+        T v;
+        #pragma omp atomic read
+        v = x;
+        return (v);
+    }
+
+    template <class T>
+    inline T atomic_decrement(T& x)
+    {
+        T v;
+        #pragma omp atomic capture
+        v = --x;
+        return (v);
+    }
+
+    template <class T>
+    inline void atomic_increment(T& x)
+    {
+        #pragma omp atomic
+        ++x;
+    }
+
+    /** Append the per thread lists to out in thread order. */
+    template <class Index>
+    void concat_thread_lists(std::vector< std::vector<Index> >& local,
+        std::vector<Index>& out)
+    {
+        out.clear();
+        for (std::size_t t=0; t < local.size(); ++t)
+        {
+            out.insert(out.end(), local[t].begin(), local[t].end());
+            local[t].clear();
+        }
+    }
+} // namespace impl
+
+/**
+ * Compute the core number of each vertex of an undirected graph.
+ *
+ * @param g the graph, with both directions of each edge stored
+ * @param core the output core numbers, size nrows(g)
+ * @param nthreads the number of threads
+ * @return the largest core number
+ */
+template <class IndexType, class ValueType, class NzSizeType, class CoreIter>
+NzSizeType parallel_core_numbers(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    CoreIter core, int nthreads=parallel_max_threads())
+{
+    const NzSizeType *ai = g.ai;
+    const IndexType *aj = g.aj;
+    IndexType n = g.nrows;
+
+    if (nthreads < 1) { nthreads = 1; }
+
+    std::vector<NzSizeType> deg(n);
+    std::vector<char> done(n, 0);
+    std::vector<IndexType> remaining(n), frontier;
+    std::vector< std::vector<IndexType> > local(nthreads);
+    std::vector<NzSizeType> localmin(nthreads);
+
+    #pragma omp parallel for schedule(static) num_threads(nthreads)
+    for (IndexType v=0; v < n; ++v)
+    {
+        deg[v] = ai[v+1] - ai[v];
+        remaining[v] = v;
+    }
+
+    NzSizeType k = 0;
+    while (!remaining.empty())
+    {
+        // drop the removed vertices and find the smallest degree left
+        // (without OpenMP only the first thread runs)
+        IndexType nr = (IndexType)remaining.size();
+        std::fill(localmin.begin(), localmin.end(),
+            (std::numeric_limits<NzSizeType>::max)());
+        #pragma omp parallel num_threads(nthreads)
+        {
+            int t = parallel_thread_num();
+            NzSizeType dmin = localmin[t];
+            #pragma omp for schedule(static)
+            for (IndexType i=0; i < nr; ++i)
+            {
+                IndexType v = remaining[i];
+                if (done[v]) { continue; }
+                local[t].push_back(v);
+                if (deg[v] < dmin) { dmin = deg[v]; }
+            }
+            localmin[t] = dmin;
+        }
+        impl::concat_thread_lists(local, remaining);
+        if (remaining.empty()) { break; }
+        k = localmin[0];
+        for (int t=1; t < nthreads; ++t)
+        {
+            if (localmin[t] < k) { k = localmin[t]; }
+        }
+
+        nr = (IndexType)remaining.size();
+        #pragma omp parallel for schedule(static) num_threads(nthreads)
+        for (IndexType i=0; i < nr; ++i)
+        {
+            IndexType v = remaining[i];
+            if (deg[v] == k) { local[parallel_thread_num()].push_back(v); }
+        }
+        impl::concat_thread_lists(local, frontier);
+
+        // peel the level
+        while (!frontier.empty())
+        {
+            IndexType nf = (IndexType)frontier.size();
+            #pragma omp parallel for schedule(dynamic,64) num_threads(nthreads)
+            for (IndexType i=0; i < nf; ++i)
+            {
+                IndexType v = frontier[i];
+                std::vector<IndexType>& next = local[parallel_thread_num()];
+                core[v] = k;
+                done[v] = 1;
+                for (NzSizeType p = ai[v]; p < ai[v+1]; ++p)
+                {
+                    IndexType u = aj[p];
+                    if (impl::atomic_read(deg[u]) <= k) { continue; }
+                    NzSizeType du = impl::atomic_decrement(deg[u]);
+                    if (du == k) { next.push_back(u); }
+                    else if (du < k) { impl::atomic_increment(deg[u]); }
+                }
+            }
+            impl::concat_thread_lists(local, frontier);
+        }
+    }
+    return (k);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_PARALLEL_CORE_NUMBERS_HPP
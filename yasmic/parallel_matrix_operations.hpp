@@ -0,0 +1,461 @@
+#ifndef YASMIC_PARALLEL_MATRIX_OPERATIONS_HPP
+#define YASMIC_PARALLEL_MATRIX_OPERATIONS_HPP
+
+/**
+ * @file parallel_matrix_operations.hpp
+ * Thread parallel versions of the matrix-vector products.
+ *
+ * The rows of the matrix are split into one piece per thread with
+ * nnz_balanced_row_partition, so a few very dense rows do not leave the
+ * other threads waiting.  Each output entry is computed by exactly one
+ * thread in the same order as the serial code, so the results are
+ * identical to mult regardless of the number of threads.
+ *
+ * The transposed product y = A^T*x scatters into y, so it uses either
+ * one private copy of y for each thread followed by a parallel
+ * reduction, or a cached transposed copy of the matrix.  See
+ * parallel_trans_mult_workspace.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/generic_matrix_operations.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    /**
+     * Compute y[r] = A(r,:)*x for the rows in [rstart, rend) of a
+     * compressed row structure.
+     */
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2>
+    inline void csr_mult_rows(RowIter ri, ColIter ci, ValIter vi,
+        Index rstart, Index rend, Iter1 x, Iter2 y)
+    {
+        typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+
+        for (Index r=rstart; r < rend; ++r)
+        {
+            Value ip = Value();
+            for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                ip += vi[cp]*x[ci[cp]];
+            }
+            y[r] = ip;
+        }
+    }
+
+    /**
+     * Run csr_mult_rows over an nnz balanced partition of the rows.
+     */
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2>
+    void parallel_csr_mult(RowIter ri, ColIter ci, ValIter vi, Index nr,
+        Iter1 x, Iter2 y, int nthreads)
+    {
+        if (nthreads < 1) { nthreads = 1; }
+        if (nthreads == 1)
+        {
+            csr_mult_rows<Value>(ri, ci, vi, (Index)0, nr, x, y);
+            return;
+        }
+
+        std::vector<Index> part(nthreads+1);
+        nnz_balanced_row_partition(ri, nr, nthreads, part.begin());
+
+        #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+        for (int p=0; p < nthreads; ++p)
+        {
+            csr_mult_rows<Value>(ri, ci, vi, part[p], part[p+1], x, y);
+        }
+    }
+} // namespace impl
+
+/**
+ * The generic parallel multiply.  A general matrix only provides a
+ * forward iterator over its nonzeros, which cannot be split among
+ * threads, so this version simply calls mult.
+ *
+ * Overloads for matrix types with row access perform the actual
+ * parallel computation.
+ */
+template <class Matrix, class Iter1, class Iter2>
+void parallel_mult(const Matrix& m, Iter1 x, Iter2 y, int /*nthreads*/)
+{
+    mult(m, x, y);
+}
+
+template <class Matrix, class Iter1, class Iter2>
+void parallel_mult(const Matrix& m, Iter1 x, Iter2 y)
+{
+    parallel_mult(m, x, y, parallel_max_threads());
+}
+
+/**
+ * Compute y = A*x in parallel for a compressed_row_matrix.  RowIter
+ * must be a random access iterator.
+ *
+ * @param m the matrix A
+ * @param x the input vector, size ncols(m)
+ * @param y the output vector, size nrows(m)
+ * @param nthreads the number of threads
+ */
+template <class RowIter, class ColIter, class ValIter, class Iter1, class Iter2>
+void parallel_mult(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, int nthreads)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+    typedef typename smatrix_traits<matrix>::value_type vtype;
+
+    itype nr = nrows(m);
+
+    impl::parallel_csr_mult<vtype>(m._rstart, m._cstart, m._vstart, nr,
+        x, y, nthreads);
+}
+
+template <class RowIter, class ColIter, class ValIter, class Iter1, class Iter2>
+void parallel_mult(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_mult(m, x, y, parallel_max_threads());
+}
+
+/**
+ * Compute y = A*x in parallel for a simple_csr_matrix.
+ *
+ * @param m the matrix A
+ * @param x the input vector, size ncols(m)
+ * @param y the output vector, size nrows(m)
+ * @param nthreads the number of threads
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_mult(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, int nthreads)
+{
+    impl::parallel_csr_mult<ValueType>(
+        (const NzSizeType*)m.ai, (const IndexType*)m.aj,
+        (const ValueType*)m.a, m.nrows, x, y, nthreads);
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_mult(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_mult(m, x, y, parallel_max_threads());
+}
+
+/**
+ * The state for parallel_trans_mult.
+ *
+ * There are two ways to compute y = A^T*x in parallel without write
+ * conflicts.
+ *   1.  Each thread scatters its rows into a private copy of y, and
+ *       then the copies are summed in parallel over the columns.  This
+ *       costs nthreads*ncols extra memory and work per product, so it 
+ *       is best when the matrix is narrow (ncols is small relative to 
+ *       nnz/nthreads).
+ *   2.  Build a compressed column copy of the matrix once and run the
+ *       parallel row product on the copy.  This costs ncols+1 offsets
+ *       and nnz indices and values of memory, but nothing extra per
+ *       product, so it is best for wide matrices used many times, as in
+ *       HITS or SALSA iterations.
+ * The workspace picks between these from the shape of the matrix and the
+ * memory budget on the first call and keeps the transposed copy (if
+ * any) for later calls.  When neither fits in the budget, the serial
+ * trans_mult is used.
+ *
+ * Each strategy is deterministic: repeated calls with the same number
+ * of threads give identical results.  The transposed copy sums each 
+ * column in row order, exactly as the serial trans_mult does.
+ *
+ * If the values of the matrix change, call reset so the copy is rebuilt.
+ */
+template <class IndexType, class ValueType, class NzSizeType=IndexType>
+struct parallel_trans_mult_workspace
+{
+    enum strategy_type
+    {
+        undecided_strategy,
+        serial_strategy,
+        private_accumulator_strategy,
+        transpose_copy_strategy
+    };
+
+    strategy_type strategy;
+    int nthreads;
+    std::size_t memory_budget;
+
+    // the private accumulators, size nthreads*ncols (times k for
+    // trans_spmm)
+    std::vector<ValueType> acc;
+
+    // the compressed column copy
+    std::vector<NzSizeType> ati;
+    std::vector<IndexType> atj;
+    std::vector<ValueType> atv;
+
+    /**
+     * @param memory_budget the number of bytes available for the 
+     *   accumulators or the transposed copy
+     * @param nthreads the number of threads
+     */
+    parallel_trans_mult_workspace(
+        std::size_t memory_budget=((std::size_t)1 << 28), 
+        int nthreads=parallel_max_threads())
+        : strategy(undecided_strategy), nthreads(nthreads < 1 ? 1 : nthreads),
+          memory_budget(memory_budget)
+    {}
+
+    /** Forget the strategy and any transposed copy. */
+    void reset()
+    {
+        strategy = undecided_strategy;
+        std::vector<ValueType>().swap(acc);
+        std::vector<NzSizeType>().swap(ati);
+        std::vector<IndexType>().swap(atj);
+        std::vector<ValueType>().swap(atv);
+    }
+
+    /**
+     * Choose a strategy for a matrix with the given shape.
+     *
+     * @param k the number of vectors multiplied at once, see trans_spmm
+     */
+    void choose_strategy(IndexType nrows, IndexType ncols, NzSizeType nnz,
+        int k=1)
+    {
+        std::size_t acc_bytes = 
+            (std::size_t)nthreads*(std::size_t)ncols*(std::size_t)k*sizeof(ValueType);
+        std::size_t copy_bytes = 
+            ((std::size_t)ncols+1)*sizeof(NzSizeType) +
+            (std::size_t)nnz*(sizeof(IndexType)+sizeof(ValueType));
+
+        // the reduction touches nthreads*ncols entries per product, so 
+        // only use it when that is less than the work of the product,
+        // one per nonzero and one per row as in the row partition
+        bool narrow = (double)nthreads*(double)ncols
+            <= (double)nnz + (double)nrows;
+
+        if (nthreads == 1)
+        {
+            strategy = serial_strategy;
+        }
+        else if (narrow && acc_bytes <= memory_budget)
+        {
+            strategy = private_accumulator_strategy;
+        }
+        else if (copy_bytes <= memory_budget)
+        {
+            strategy = transpose_copy_strategy;
+        }
+        else if (acc_bytes <= memory_budget)
+        {
+            strategy = private_accumulator_strategy;
+        }
+        else
+        {
+            strategy = serial_strategy;
+        }
+    }
+};
+
+namespace impl
+{
+    /**
+     * Build a compressed column copy (with values) of a compressed row
+     * structure with a counting sort.  Within each column, the entries
+     * are in row order.
+     */
+    template <class RowIter, class ColIter, class ValIter, class Index,
+        class NzSize, class Value>
+    void csr_transpose_copy(RowIter ri, ColIter ci, ValIter vi, 
+        Index nr, Index nc, std::vector<NzSize>& ati, 
+        std::vector<Index>& atj, std::vector<Value>& atv)
+    {
+        NzSize nz = (NzSize)(ri[nr] - ri[0]);
+        ati.assign(nc+1, 0);
+        atj.resize(nz);
+        atv.resize(nz);
+
+        for (NzSize cp = ri[0]; cp < ri[nr]; ++cp) { ++ati[ci[cp]+1]; }
+        for (Index c=0; c < nc; ++c) { ati[c+1] += ati[c]; }
+        for (Index r=0; r < nr; ++r)
+        {
+            for (NzSize cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                NzSize p = ati[ci[cp]]++;
+                atj[p] = r;
+                atv[p] = vi[cp];
+            }
+        }
+        // shift the column pointers back
+        for (Index c=nc; c > 0; --c) { ati[c] = ati[c-1]; }
+        ati[0] = 0;
+    }
+
+    template <class RowIter, class ColIter, class ValIter, class Index,
+        class Iter1, class Iter2, class Workspace>
+    void parallel_csr_trans_mult(RowIter ri, ColIter ci, ValIter vi,
+        Index nr, Index nc, Iter1 x, Iter2 y, Workspace& w)
+    {
+        typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+        typedef typename std::iterator_traits<ValIter>::value_type vtype;
+
+        if (w.strategy == Workspace::undecided_strategy)
+        {
+            w.choose_strategy(nr, nc, ri[nr] - ri[0]);
+        }
+
+        if (w.strategy == Workspace::transpose_copy_strategy)
+        {
+            if (w.ati.size() != (std::size_t)nc+1)
+            {
+                csr_transpose_copy(ri, ci, vi, nr, nc, w.ati, w.atj, w.atv);
+            }
+            parallel_csr_mult<vtype>(&w.ati[0], 
+                w.atj.empty() ? (const Index*)0 : &w.atj[0], 
+                w.atv.empty() ? (const vtype*)0 : &w.atv[0], 
+                nc, x, y, w.nthreads);
+        }
+        else if (w.strategy == Workspace::private_accumulator_strategy)
+        {
+            int nthreads = w.nthreads;
+            w.acc.resize((std::size_t)nthreads*(std::size_t)nc);
+
+            std::vector<Index> part(nthreads+1);
+            nnz_balanced_row_partition(ri, nr, nthreads, part.begin());
+
+            #pragma omp parallel num_threads(nthreads)
+            {
+                #pragma omp for schedule(static,1)
+                for (int p=0; p < nthreads; ++p)
+                {
+                    vtype *acc = &w.acc[(std::size_t)p*(std::size_t)nc];
+                    for (Index c=0; c < nc; ++c) { acc[c] = vtype(); }
+                    for (Index r=part[p]; r < part[p+1]; ++r)
+                    {
+                        vtype xv = x[r];
+                        for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+                        {
+                            acc[ci[cp]] += vi[cp]*xv;
+                        }
+                    }
+                }
+
+                // reduce the accumulators in a fixed order
+                #pragma omp for schedule(static)
+                for (Index c=0; c < nc; ++c)
+                {
+                    vtype sum = vtype();
+                    for (int p=0; p < nthreads; ++p)
+                    {
+                        sum += w.acc[(std::size_t)p*(std::size_t)nc + c];
+                    }
+                    y[c] = sum;
+                }
+            }
+        }
+        else
+        {
+            for (Index c=0; c < nc; ++c) { y[c] = vtype(); }
+            for (Index r=0; r < nr; ++r)
+            {
+                vtype xv = x[r];
+                for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+                {
+                    y[ci[cp]] += vi[cp]*xv;
+                }
+            }
+        }
+    }
+} // namespace impl
+
+/**
+ * Compute y = A^T*x in parallel for a simple_csr_matrix.
+ *
+ * @param m the matrix A
+ * @param x the input vector, size nrows(m)
+ * @param y the output vector, size ncols(m)
+ * @param w the workspace, reuse it for repeated products with the same
+ *   matrix
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_trans_mult(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, 
+    parallel_trans_mult_workspace<IndexType, ValueType, NzSizeType>& w)
+{
+    impl::parallel_csr_trans_mult(
+        (const NzSizeType*)m.ai, (const IndexType*)m.aj,
+        (const ValueType*)m.a, m.nrows, m.ncols, x, y, w);
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void parallel_trans_mult(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    parallel_trans_mult_workspace<IndexType, ValueType, NzSizeType> w;
+    parallel_trans_mult(m, x, y, w);
+}
+
+/**
+ * Compute y = A^T*x in parallel for a compressed_row_matrix.  RowIter 
+ * must be a random access iterator.
+ *
+ * @param m the matrix A
+ * @param x the input vector, size nrows(m)
+ * @param y the output vector, size ncols(m)
+ * @param w the workspace, reuse it for repeated products with the same
+ *   matrix
+ */
+template <class RowIter, class ColIter, class ValIter, 
+    class Iter1, class Iter2, class Workspace>
+void parallel_trans_mult(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, Workspace& w)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+
+    itype nr = nrows(m);
+    itype nc = ncols(m);
+
+    impl::parallel_csr_trans_mult(m._rstart, m._cstart, m._vstart, 
+        nr, nc, x, y, w);
+}
+
+template <class RowIter, class ColIter, class ValIter, 
+    class Iter1, class Iter2>
+void parallel_trans_mult(
+    const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+    typedef typename smatrix_traits<matrix>::value_type vtype;
+
+    parallel_trans_mult_workspace<itype, vtype> w;
+    parallel_trans_mult(m, x, y, w);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_PARALLEL_MATRIX_OPERATIONS_HPP
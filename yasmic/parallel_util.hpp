@@ -0,0 +1,129 @@
+#ifndef YASMIC_PARALLEL_UTIL_HPP
+#define YASMIC_PARALLEL_UTIL_HPP
+
+/**
+ * @file parallel_util.hpp
+ * Small wrappers around OpenMP and the row partitioning used by the
+ * parallel matrix kernels.
+ *
+ * All of the parallel code in yasmic uses OpenMP pragmas.  When the
+ * compiler does not support OpenMP (or it is not enabled) the pragmas
+ * are ignored and these functions report a single thread, so every
+ * parallel kernel reduces to its serial counterpart.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <ctime>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+namespace yasmic
+{
+
+/**
+ * Return the number of threads a parallel region will use by default.
+ */
+inline int parallel_max_threads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif // _OPENMP
+}
+
+/**
+ * Return the id of the calling thread inside a parallel region.
+ */
+inline int parallel_thread_num()
+{
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif // _OPENMP
+}
+
+/**
+ * Return the number of threads in the team of the enclosing parallel
+ * region, which may be fewer than were asked for.
+ */
+inline int parallel_num_threads()
+{
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif // _OPENMP
+}
+
+/**
+ * Return a wall clock time in seconds for timing parallel code.  Without
+ * OpenMP this falls back to the processor time from std::clock.
+ */
+inline double parallel_wtime()
+{
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)std::clock()/(double)CLOCKS_PER_SEC;
+#endif // _OPENMP
+}
+
+/**
+ * Partition the rows of a compressed row structure into nparts pieces
+ * with about the same amount of work.
+ *
+ * The work for a row is its number of nonzeros plus one, so that a
+ * long run of empty rows still costs something.  The cumulative work
+ * rp[r] - rp[0] + r is strictly increasing, so each split point is
+ * found by a binary search over the row pointer.  This keeps a single
+ * high degree row from stalling all of the other threads.
+ *
+ * @param rp the row pointer array (random access, size nrows+1)
+ * @param nrows the number of rows
+ * @param nparts the number of pieces
+ * @param part the output, size nparts+1, part k is rows
+ *   [part[k], part[k+1])
+ */
+template <class RowIter, class Index, class PartIter>
+void nnz_balanced_row_partition(RowIter rp, Index nrows, int nparts,
+                                PartIter part)
+{
+    typedef Index itype;
+
+    double total = (double)(rp[nrows] - rp[0]) + (double)nrows;
+
+    part[0] = 0;
+    for (int k=1; k < nparts; ++k)
+    {
+        double target = total*(double)k/(double)nparts;
+
+        // find the first row r with work(r) >= target
+        itype lo = 0, hi = nrows;
+        while (lo < hi)
+        {
+            itype mid = lo + (hi - lo)/2;
+            if ((double)(rp[mid] - rp[0]) + (double)mid < target)
+            {
+                lo = mid+1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        part[k] = lo;
+    }
+    part[nparts] = nrows;
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_PARALLEL_UTIL_HPP
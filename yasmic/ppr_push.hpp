@@ -0,0 +1,199 @@
+#ifndef YASMIC_PPR_PUSH_HPP
+#define YASMIC_PPR_PUSH_HPP
+
+/**
+ * @file ppr_push.hpp
+ * Approximate personalized PageRank with the push method of Andersen,
+ * Chung, and Lang over an undirected graph in a simple_csr_matrix.
+ *
+ * The method keeps a solution x and a residual r, both sparse, with
+ * r = e_seed at the start.  While some vertex u has r(u) >= eps*d(u),
+ * it moves (1-alpha)*r(u) to x(u) and spreads alpha*r(u) evenly over
+ * the neighbors of u.  At the end
+ *
+ *   x + ppr(r) = ppr(e_seed), and r(u) < eps*d(u) for all u,
+ *
+ * where ppr(s) = (1-alpha)*s + alpha*P'*ppr(s) with P = D^{-1}A.  Each
+ * push removes at least (1-alpha)*eps*d(u) from |r|_1, so the total
+ * work, the sum of the degrees of the pushed vertices, is at most
+ * 1/(eps*(1-alpha)) and does not depend on the size of the graph.
+ *
+ * The degrees are the number of neighbors and the edge values are not
+ * used.  x and r are sparse_maps and the vertices with a large residual
+ * are kept in a FIFO queue.  A ppr_push_workspace holds these between
+ * calls, so many seeds can be solved with one allocation, and
+ * ppr_push_batch solves a list of seeds in parallel with one workspace
+ * per thread.
+ *
+ * R. Andersen, F. Chung, and K. Lang, "Local graph partitioning using
+ * PageRank vectors," FOCS 2006.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/sparse_map.hpp>
+#include <yasmic/semiring_operations.hpp>
+
+namespace yasmic
+{
+
+/**
+ * The state for ppr_push, keep it between the calls for many seeds.
+ */
+template <class Index, class Value>
+struct ppr_push_workspace
+{
+    sparse_map<Index, Value> x;
+    sparse_map<Index, Value> r;
+
+    // the vertices with r(u) >= eps*d(u), the queue is queue[head:]
+    std::vector<Index> queue;
+    std::size_t head;
+
+    // the number of pushes and the work (the sum of the degrees of the
+    // pushed vertices) of the last call
+    std::size_t npushes;
+    std::size_t work;
+
+    ppr_push_workspace() : head(0), npushes(0), work(0) {}
+};
+
+/**
+ * Compute an approximate personalized PageRank vector for a seed set
+ * with the push method.
+ *
+ * @param g the undirected graph, g.ai and g.aj are used
+ * @param first the first seed
+ * @param last the end of the seeds, the mass starts uniform over them
+ * @param alpha the PageRank parameter, the probability of following
+ *   a link
+ * @param eps the tolerance, at the end r(u) < eps*d(u) for all u
+ * @param y the output, the nonzeros of x in the order they were found
+ * @param w the workspace, w.r holds the final residual
+ * @return the number of pushes
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class SeedIter, class Value>
+std::size_t ppr_push(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    SeedIter first, SeedIter last, Value alpha, Value eps,
+    sparse_vector<IndexType, Value>& y,
+    ppr_push_workspace<IndexType, Value>& w)
+{
+    const NzSizeType *ai = g.ai;
+    const IndexType *aj = g.aj;
+
+    w.x.clear();
+    w.r.clear();
+    w.queue.clear();
+    w.head = 0;
+    w.npushes = 0;
+    w.work = 0;
+    y.clear();
+
+    std::size_t nseeds = 0;
+    for (SeedIter si = first; si != last; ++si) { ++nseeds; }
+    if (nseeds == 0) { return (0); }
+
+    for (SeedIter si = first; si != last; ++si)
+    {
+        IndexType s = *si;
+        Value& rs = w.r[s];
+        if (rs == Value()) { w.queue.push_back(s); }
+        rs += Value(1)/(Value)nseeds;
+    }
+
+    while (w.head < w.queue.size())
+    {
+        IndexType u = w.queue[w.head++];
+        NzSizeType du = ai[u+1] - ai[u];
+        Value ru = w.r.get(u);
+        if (ru < eps*(Value)du) { continue; }
+
+        w.r[u] = Value();
+        ++w.npushes;
+        w.work += du;
+
+        // a vertex without neighbors keeps all of its mass
+        if (du == 0) { w.x[u] += ru; continue; }
+
+        w.x[u] += (Value(1) - alpha)*ru;
+        Value rho = alpha*ru/(Value)du;
+        for (NzSizeType k = ai[u]; k < ai[u+1]; ++k)
+        {
+            IndexType v = aj[k];
+            Value& rv = w.r[v];
+            Value thresh = eps*(Value)(ai[v+1] - ai[v]);
+            bool below = rv < thresh;
+            rv += rho;
+            if (below && rv >= thresh) { w.queue.push_back(v); }
+        }
+    }
+
+    for (std::size_t i=0; i < w.x.size(); ++i)
+    {
+        y.push_back(w.x.key(i), w.x.value(i));
+    }
+    return (w.npushes);
+}
+
+/**
+ * Compute an approximate personalized PageRank vector for one seed.
+ */
+template <class IndexType, class ValueType, class NzSizeType, class Value>
+std::size_t ppr_push(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    IndexType seed, Value alpha, Value eps,
+    sparse_vector<IndexType, Value>& y,
+    ppr_push_workspace<IndexType, Value>& w)
+{
+    return (ppr_push(g, &seed, &seed + 1, alpha, eps, y, w));
+}
+
+/**
+ * Compute an approximate personalized PageRank vector for each seed in
+ * a list.  The seeds are split dynamically among threads, each with its
+ * own workspace.
+ *
+ * @param ys the outputs, ys[i] is the vector for seed first[i]
+ * @return the total number of pushes
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class SeedIter, class Value>
+std::size_t ppr_push_batch(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    SeedIter first, SeedIter last, Value alpha, Value eps,
+    std::vector< sparse_vector<IndexType, Value> >& ys,
+    int nthreads=parallel_max_threads())
+{
+    std::vector<IndexType> seeds(first, last);
+    int nseeds = (int)seeds.size();
+    ys.resize(nseeds);
+
+    if (nthreads < 1) { nthreads = 1; }
+    if (nthreads > nseeds) { nthreads = nseeds > 0 ? nseeds : 1; }
+
+    std::vector< ppr_push_workspace<IndexType, Value> > ws(nthreads);
+    std::vector<std::size_t> pushes(nthreads, 0);
+
+    #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads)
+    for (int i=0; i < nseeds; ++i)
+    {
+        int t = parallel_thread_num();
+        pushes[t] += ppr_push(g, seeds[i], alpha, eps, ys[i], ws[t]);
+    }
+
+    std::size_t total = 0;
+    for (int t=0; t < nthreads; ++t) { total += pushes[t]; }
+    return (total);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_PPR_PUSH_HPP
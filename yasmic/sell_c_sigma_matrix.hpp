@@ -0,0 +1,435 @@
+#ifndef YASMIC_SELL_C_SIGMA_MATRIX_HPP
+#define YASMIC_SELL_C_SIGMA_MATRIX_HPP
+
+/**
+ * @file sell_c_sigma_matrix.hpp
+ * A SELL-C-sigma (sliced ELLPACK) matrix for vectorized y = A*x.
+ *
+ * The rows are sorted by decreasing length inside windows of sigma
+ * rows, and then packed C rows at a time into chunks.  A chunk is
+ * stored column major and padded with zeros to the length of its
+ * longest row, so one SIMD lane handles one row and each step over a
+ * chunk is a contiguous load of C values and C column indices.  Sorting
+ * puts rows of about the same length together, which keeps the padding
+ * small.  The padding is reported by build_sell_from_csr, if it is
+ * large CSR is the better choice.
+ *
+ * The format comes from:
+ * Moritz Kreutzer, Georg Hager, Gerhard Wellein, Holger Fehske, and
+ * Alan R. Bishop, "A unified sparse matrix data format for efficient
+ * general sparse matrix-vector multiplication on modern processors with
+ * wide SIMD units."  SIAM J. Sci. Comput. 36(5), 2014.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simd_csr_kernels.hpp>
+
+namespace yasmic
+{
+
+/**
+ * sell_c_sigma_matrix owns its storage, build it with
+ * build_sell_from_csr.
+ *
+ * Chunk k holds the rows perm[k*C ... k*C+C) of the original matrix.
+ * Entry j of lane i in chunk k is at position cs[k] + j*C + i of aj and
+ * a, for j < cl[k].  Padding entries have column 0 and value 0, the
+ * lanes past nrows in the last chunk are all padding.
+ */
+template <class IndexType, class ValueType, class NzSizeType=IndexType>
+struct sell_c_sigma_matrix
+{
+    IndexType nrows;
+    IndexType ncols;
+    NzSizeType nnz;
+
+    // the chunk height and the sorting window
+    int c;
+    IndexType sigma;
+    IndexType nchunks;
+
+    // the original row of each sorted row, size nrows
+    std::vector<IndexType> perm;
+    // the start of each chunk, size nchunks+1
+    std::vector<NzSizeType> cs;
+    // the length of each chunk, size nchunks
+    std::vector<IndexType> cl;
+    // the column indices and values, size cs[nchunks]
+    std::vector<IndexType> aj;
+    std::vector<ValueType> a;
+
+    sell_c_sigma_matrix()
+        : nrows(0), ncols(0), nnz(0), c(1), sigma(1), nchunks(0), cs(1, 0) {}
+
+    /**
+     * The number of stored padding entries over the number of
+     * nonzeros.
+     */
+    double padding_overhead() const
+    {
+        return (nnz > 0 ? (double)(cs[nchunks] - nnz)/(double)nnz : 0.0);
+    }
+};
+
+template <class IndexType, class ValueType, class NzSizeType>
+struct smatrix_traits< sell_c_sigma_matrix<IndexType, ValueType, NzSizeType> >
+{
+    typedef IndexType index_type;
+    typedef ValueType value_type;
+
+    typedef NzSizeType nz_size_type;
+    typedef NzSizeType nz_index_type;
+
+    typedef no_property_tag properties;
+};
+
+template <class IndexType, class ValueType, class NzSizeType>
+IndexType nrows(const sell_c_sigma_matrix<IndexType, ValueType, NzSizeType>& m)
+{ return m.nrows; }
+
+template <class IndexType, class ValueType, class NzSizeType>
+IndexType ncols(const sell_c_sigma_matrix<IndexType, ValueType, NzSizeType>& m)
+{ return m.ncols; }
+
+template <class IndexType, class ValueType, class NzSizeType>
+NzSizeType nnz(const sell_c_sigma_matrix<IndexType, ValueType, NzSizeType>& m)
+{ return m.nnz; }
+
+namespace impl
+{
+    template <class IndexType, class NzSizeType>
+    struct sell_longer_row
+    {
+        const NzSizeType* ai;
+        sell_longer_row(const NzSizeType* ai) : ai(ai) {}
+        bool operator()(IndexType r, IndexType s) const
+        {
+            return (ai[r+1] - ai[r] > ai[s+1] - ai[s]);
+        }
+    };
+
+    template <class IndexType, class ValueType, class NzSizeType,
+        class Iter1, class Iter2>
+    void sell_mult_chunks_scalar(
+        const sell_c_sigma_matrix<IndexType, ValueType, NzSizeType>& m,
+        IndexType k0, IndexType k1, Iter1 x, Iter2 y)
+    {
+        int c = m.c;
+        for (IndexType k = k0; k < k1; ++k)
+        {
+            IndexType r0 = k*c;
+            for (int i=0; i < c && r0+i < m.nrows; ++i)
+            {
+                ValueType sum = ValueType();
+                for (NzSizeType p = m.cs[k]+i; p < m.cs[k+1]; p += c)
+                {
+                    sum += m.a[p]*x[m.aj[p]];
+                }
+                y[m.perm[r0+i]] = sum;
+            }
+        }
+    }
+
+#ifdef YASMIC_SIMD_X86
+
+    /*
+     * The vector kernels handle W = the vector width lanes at a time,
+     * so they need C to be a multiple of W.
+     */
+
+    YASMIC_SIMD_TARGET("avx2")
+    inline void sell_mult_chunks_avx2(
+        const sell_c_sigma_matrix<int,double,int>& m,
+        int k0, int k1, const double* x, double* y)
+    {
+        int c = m.c;
+        const int* aj = m.aj.empty() ? 0 : &m.aj[0];
+        const double* a = m.a.empty() ? 0 : &m.a[0];
+        double out[4];
+        const __m256d all4 = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (int k = k0; k < k1; ++k)
+        {
+            for (int g = 0; g < c; g += 4)
+            {
+                __m256d acc = _mm256_setzero_pd();
+                for (int p = m.cs[k]+g; p < m.cs[k+1]; p += c)
+                {
+                    __m128i j = _mm_loadu_si128((const __m128i*)(aj+p));
+                    acc = _mm256_add_pd(acc, _mm256_mul_pd(
+                        _mm256_loadu_pd(a+p),
+                        _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, j, all4, 8)));
+                }
+                _mm256_storeu_pd(out, acc);
+                int r0 = k*c + g;
+                for (int i=0; i < 4 && r0+i < m.nrows; ++i) { y[m.perm[r0+i]] = out[i]; }
+            }
+        }
+    }
+
+    YASMIC_SIMD_TARGET("avx2")
+    inline void sell_mult_chunks_avx2(
+        const sell_c_sigma_matrix<int,float,int>& m,
+        int k0, int k1, const float* x, float* y)
+    {
+        int c = m.c;
+        const int* aj = m.aj.empty() ? 0 : &m.aj[0];
+        const float* a = m.a.empty() ? 0 : &m.a[0];
+        float out[8];
+        const __m256 all8 = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int k = k0; k < k1; ++k)
+        {
+            for (int g = 0; g < c; g += 8)
+            {
+                __m256 acc = _mm256_setzero_ps();
+                for (int p = m.cs[k]+g; p < m.cs[k+1]; p += c)
+                {
+                    __m256i j = _mm256_loadu_si256((const __m256i*)(aj+p));
+                    acc = _mm256_add_ps(acc, _mm256_mul_ps(
+                        _mm256_loadu_ps(a+p),
+                        _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, j, all8, 4)));
+                }
+                _mm256_storeu_ps(out, acc);
+                int r0 = k*c + g;
+                for (int i=0; i < 8 && r0+i < m.nrows; ++i) { y[m.perm[r0+i]] = out[i]; }
+            }
+        }
+    }
+
+    YASMIC_SIMD_TARGET("avx512f")
+    inline void sell_mult_chunks_avx512(
+        const sell_c_sigma_matrix<int,double,int>& m,
+        int k0, int k1, const double* x, double* y)
+    {
+        int c = m.c;
+        const int* aj = m.aj.empty() ? 0 : &m.aj[0];
+        const double* a = m.a.empty() ? 0 : &m.a[0];
+        double out[8];
+        for (int k = k0; k < k1; ++k)
+        {
+            for (int g = 0; g < c; g += 8)
+            {
+                __m512d acc = _mm512_setzero_pd();
+                for (int p = m.cs[k]+g; p < m.cs[k+1]; p += c)
+                {
+                    __m256i j = _mm256_loadu_si256((const __m256i*)(aj+p));
+                    acc = _mm512_add_pd(acc, _mm512_mul_pd(
+                        _mm512_loadu_pd(a+p),
+                        _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, j, x, 8)));
+                }
+                _mm512_storeu_pd(out, acc);
+                int r0 = k*c + g;
+                for (int i=0; i < 8 && r0+i < m.nrows; ++i) { y[m.perm[r0+i]] = out[i]; }
+            }
+        }
+    }
+
+    YASMIC_SIMD_TARGET("avx512f")
+    inline void sell_mult_chunks_avx512(
+        const sell_c_sigma_matrix<int,float,int>& m,
+        int k0, int k1, const float* x, float* y)
+    {
+        int c = m.c;
+        const int* aj = m.aj.empty() ? 0 : &m.aj[0];
+        const float* a = m.a.empty() ? 0 : &m.a[0];
+        float out[16];
+        for (int k = k0; k < k1; ++k)
+        {
+            for (int g = 0; g < c; g += 16)
+            {
+                __m512 acc = _mm512_setzero_ps();
+                for (int p = m.cs[k]+g; p < m.cs[k+1]; p += c)
+                {
+                    __m512i j = _mm512_loadu_si512((const void*)(aj+p));
+                    acc = _mm512_add_ps(acc, _mm512_mul_ps(
+                        _mm512_loadu_ps(a+p),
+                        _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xffff, j, x, 4)));
+                }
+                _mm512_storeu_ps(out, acc);
+                int r0 = k*c + g;
+                for (int i=0; i < 16 && r0+i < m.nrows; ++i) { y[m.perm[r0+i]] = out[i]; }
+            }
+        }
+    }
+
+#endif // YASMIC_SIMD_X86
+
+    /**
+     * Pick the kernel for a range of chunks.  A level is only used when
+     * C is a multiple of its vector width.
+     */
+    template <class Value>
+    inline void sell_mult_chunks_simd(simd_level level,
+        const sell_c_sigma_matrix<int,Value,int>& m,
+        int k0, int k1, const Value* x, Value* y)
+    {
+        if (k0 >= k1) { return; }
+#ifdef YASMIC_SIMD_X86
+        int lanes = (int)(32/sizeof(Value));
+        if (level >= simd_avx512 && m.c % (2*lanes) == 0)
+        {
+            sell_mult_chunks_avx512(m, k0, k1, x, y);
+            return;
+        }
+        if (level >= simd_avx2 && m.c % lanes == 0)
+        {
+            sell_mult_chunks_avx2(m, k0, k1, x, y);
+            return;
+        }
+#endif // YASMIC_SIMD_X86
+        sell_mult_chunks_scalar(m, k0, k1, x, y);
+    }
+} // namespace impl
+
+/**
+ * Build a sell_c_sigma_matrix from a simple_csr_matrix.
+ *
+ * @param m the csr matrix
+ * @param s the output matrix
+ * @param c the chunk height, use the SIMD width of the value type
+ *   (8 doubles or 16 floats for AVX-512, half that for AVX2)
+ * @param sigma the sorting window, a multiple of c; 1 does not sort
+ *   and nrows(m) sorts all of the rows
+ * @return the padding overhead, the number of padding entries over
+ *   the number of nonzeros
+ */
+template <class IndexType, class ValueType, class NzSizeType>
+double build_sell_from_csr(
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    sell_c_sigma_matrix<IndexType, ValueType, NzSizeType>& s,
+    int c=8, IndexType sigma=256)
+{
+    if (c < 1) { c = 1; }
+    if (sigma < 1) { sigma = 1; }
+
+    s.nrows = m.nrows;
+    s.ncols = m.ncols;
+    s.nnz = m.ai[m.nrows] - m.ai[0];
+    s.c = c;
+    s.sigma = sigma;
+    s.nchunks = (m.nrows + c - 1)/c;
+
+    // sort by decreasing row length in each window, stable so rows of
+    // the same length keep their order
+    s.perm.resize(m.nrows);
+    for (IndexType r=0; r < m.nrows; ++r) { s.perm[r] = r; }
+    for (IndexType w=0; w < m.nrows; w += sigma)
+    {
+        IndexType wend = std::min((IndexType)(w + sigma), m.nrows);
+        std::stable_sort(s.perm.begin()+w, s.perm.begin()+wend,
+            impl::sell_longer_row<IndexType, NzSizeType>(m.ai));
+    }
+
+    s.cs.resize(s.nchunks+1);
+    s.cl.resize(s.nchunks);
+    s.cs[0] = 0;
+    for (IndexType k=0; k < s.nchunks; ++k)
+    {
+        IndexType len = 0;
+        for (IndexType r=k*c; r < std::min((IndexType)(k*c+c), m.nrows); ++r)
+        {
+            IndexType rlen = (IndexType)(m.ai[s.perm[r]+1] - m.ai[s.perm[r]]);
+            len = std::max(len, rlen);
+        }
+        s.cl[k] = len;
+        s.cs[k+1] = s.cs[k] + (NzSizeType)len*(NzSizeType)c;
+    }
+
+    s.aj.assign(s.cs[s.nchunks], 0);
+    s.a.assign(s.cs[s.nchunks], ValueType());
+    for (IndexType r=0; r < m.nrows; ++r)
+    {
+        IndexType k = r/c, i = r%c, orig = s.perm[r];
+        NzSizeType p = s.cs[k] + i;
+        for (NzSizeType cp = m.ai[orig]; cp < m.ai[orig+1]; ++cp, p += c)
+        {
+            s.aj[p] = m.aj[cp];
+            s.a[p] = m.a[cp];
+        }
+    }
+
+    return (s.padding_overhead());
+}
+
+/**
+ * Compute y = A*x.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void mult(const sell_c_sigma_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    impl::sell_mult_chunks_scalar(m, (IndexType)0, m.nchunks, x, y);
+}
+
+/*
+ * This overload is required so that a non-const matrix does not select
+ * the nonzero iterator version of mult in generic_matrix_operations.hpp.
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void mult(sell_c_sigma_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y)
+{
+    impl::sell_mult_chunks_scalar(m, (IndexType)0, m.nchunks, x, y);
+}
+
+/**
+ * Compute y = A*x with the vectorized kernels, one row per SIMD lane.
+ *
+ * @param m the matrix A, a sell_c_sigma_matrix<int,double> or
+ *   sell_c_sigma_matrix<int,float>
+ * @param x the input vector, size ncols(m)
+ * @param y the output vector, size nrows(m)
+ * @param nthreads the number of threads, the chunks are split with
+ *   nnz_balanced_row_partition
+ * @param level the instruction set to use, this is reduced to what
+ *   the processor supports
+ */
+template <class Value>
+void simd_mult(const sell_c_sigma_matrix<int,Value,int>& m,
+    const Value* x, Value* y, int nthreads, simd_level level)
+{
+    if (level > simd_detect_level()) { level = simd_detect_level(); }
+    if (nthreads < 1) { nthreads = 1; }
+    if (nthreads == 1)
+    {
+        impl::sell_mult_chunks_simd(level, m, 0, m.nchunks, x, y);
+        return;
+    }
+
+    std::vector<int> part(nthreads+1);
+    nnz_balanced_row_partition(m.cs.begin(), m.nchunks, nthreads, part.begin());
+
+    #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+    for (int p=0; p < nthreads; ++p)
+    {
+        impl::sell_mult_chunks_simd(level, m, part[p], part[p+1], x, y);
+    }
+}
+
+template <class Value>
+void simd_mult(const sell_c_sigma_matrix<int,Value,int>& m,
+    const Value* x, Value* y, int nthreads)
+{
+    simd_mult(m, x, y, nthreads, simd_detect_level());
+}
+
+template <class Value>
+void simd_mult(const sell_c_sigma_matrix<int,Value,int>& m,
+    const Value* x, Value* y)
+{
+    simd_mult(m, x, y, 1, simd_detect_level());
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_SELL_C_SIGMA_MATRIX_HPP
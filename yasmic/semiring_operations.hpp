@@ -0,0 +1,501 @@
+#ifndef YASMIC_SEMIRING_OPERATIONS_HPP
+#define YASMIC_SEMIRING_OPERATIONS_HPP
+
+/**
+ * @file semiring_operations.hpp
+ * Matrix-vector products over a semiring, for graph algorithms written
+ * as linear algebra: breadth first search over (or, and), shortest path
+ * relaxation over (min, +), and widest path over (max, min).
+ *
+ * A semiring is a struct with a value_type and three static functions,
+ * zero(), add(a,b), and mult(a,b), where zero() is the identity of add.
+ * The matrix values are converted to the value_type before mult.
+ *
+ * semiring_mult computes the dense y = A*x, split among threads by
+ * rows.  semiring_spmspv computes y = A^T*x for a sparse x, which is
+ * one step of a frontier expansion: the new frontier is every column j
+ * with an entry A(i,j) for i in the frontier.  It pushes along the rows
+ * of the frontier, or, for a simple_row_and_column_matrix, pulls along
+ * the columns when the frontier is dense.
+ *
+ * Both can take a mask over the output.  Only the entries j where
+ * mask[j] is true, or false with complement, are computed, the others
+ * are left unchanged (dense) or not included (sparse).  A complemented
+ * mask of the visited vertices keeps a search from returning to them.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/simple_row_and_column_matrix.hpp>
+
+namespace yasmic
+{
+
+/**
+ * The usual (+, *) semiring.
+ */
+template <class T>
+struct plus_times_semiring
+{
+    typedef T value_type;
+    static T zero() { return T(); }
+    static T add(T a, T b) { return a + b; }
+    static T mult(T a, T b) { return a * b; }
+};
+
+/**
+ * The boolean (or, and) semiring for reachability.
+ */
+struct or_and_semiring
+{
+    typedef bool value_type;
+    static bool zero() { return false; }
+    static bool add(bool a, bool b) { return a || b; }
+    static bool mult(bool a, bool b) { return a && b; }
+};
+
+/**
+ * The tropical (min, +) semiring for shortest paths.  The zero is
+ * infinity (or the largest value) and absorbs mult, so it never
+ * overflows.
+ */
+template <class T>
+struct min_plus_semiring
+{
+    typedef T value_type;
+    static T zero()
+    {
+        return std::numeric_limits<T>::has_infinity ?
+            std::numeric_limits<T>::infinity() : (std::numeric_limits<T>::max)();
+    }
+    static T add(T a, T b) { return b < a ? b : a; }
+    static T mult(T a, T b)
+    {
+        return (a == zero() || b == zero()) ? zero() : a + b;
+    }
+};
+
+/**
+ * The (max, min) semiring for widest (bottleneck) paths.
+ */
+template <class T>
+struct max_min_semiring
+{
+    typedef T value_type;
+    static T zero()
+    {
+        return std::numeric_limits<T>::has_infinity ?
+            -std::numeric_limits<T>::infinity() :
+            (std::numeric_limits<T>::is_integer ?
+                (std::numeric_limits<T>::min)() : -(std::numeric_limits<T>::max)());
+    }
+    static T add(T a, T b) { return a < b ? b : a; }
+    static T mult(T a, T b) { return b < a ? b : a; }
+};
+
+/**
+ * A sparse vector, the nonzero entries val[k] at the indices ind[k].
+ */
+template <class Index, class Value>
+struct sparse_vector
+{
+    std::vector<Index> ind;
+    std::vector<Value> val;
+
+    std::size_t size() const { return (ind.size()); }
+    void clear() { ind.clear(); val.clear(); }
+    void push_back(Index i, Value v) { ind.push_back(i); val.push_back(v); }
+};
+
+/**
+ * The state for semiring_spmspv, keep it between the steps of a
+ * search so the dense arrays are allocated once.
+ */
+template <class Index, class Value>
+struct spmspv_workspace
+{
+    enum direction_type
+    {
+        auto_direction,
+        push_direction,
+        pull_direction
+    };
+
+    // the direction to use, and the direction used by the last call
+    direction_type direction;
+    direction_type last_direction;
+
+    // pull when (the number of entries in the rows of x)*alpha is more
+    // than nnz(A), following Beamer's direction optimizing search
+    double alpha;
+
+    int nthreads;
+
+    // dense copies of x and y
+    std::vector<char> xmark, ymark;
+    std::vector<Value> xval, yval;
+
+    spmspv_workspace(direction_type direction=auto_direction,
+        double alpha=14.0, int nthreads=parallel_max_threads())
+        : direction(direction), last_direction(push_direction),
+          alpha(alpha), nthreads(nthreads < 1 ? 1 : nthreads)
+    {}
+};
+
+namespace impl
+{
+    template <class Index>
+    struct semiring_no_mask
+    {
+        bool operator()(Index) const { return (true); }
+    };
+
+    template <class Index, class MaskIter>
+    struct semiring_vector_mask
+    {
+        MaskIter mask;
+        bool complement;
+        semiring_vector_mask(MaskIter mask, bool complement)
+            : mask(mask), complement(complement) {}
+        bool operator()(Index j) const { return (mask[j] ? !complement : complement); }
+    };
+
+    template <class Semiring, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2, class Mask>
+    void semiring_mult_rows(RowIter ri, ColIter ci, ValIter vi,
+        Index rstart, Index rend, Iter1 x, Iter2 y, const Mask& mask)
+    {
+        typedef typename Semiring::value_type vtype;
+        typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+
+        for (Index r=rstart; r < rend; ++r)
+        {
+            if (!mask(r)) { continue; }
+            vtype ip = Semiring::zero();
+            for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+            {
+                ip = Semiring::add(ip, Semiring::mult((vtype)vi[cp], x[ci[cp]]));
+            }
+            y[r] = ip;
+        }
+    }
+
+    template <class Semiring, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2, class Mask>
+    void parallel_semiring_mult(RowIter ri, ColIter ci, ValIter vi, Index nr,
+        Iter1 x, Iter2 y, const Mask& mask, int nthreads)
+    {
+        if (nthreads < 1) { nthreads = 1; }
+        if (nthreads == 1)
+        {
+            semiring_mult_rows<Semiring>(ri, ci, vi, (Index)0, nr, x, y, mask);
+            return;
+        }
+
+        std::vector<Index> part(nthreads+1);
+        nnz_balanced_row_partition(ri, nr, nthreads, part.begin());
+
+        #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+        for (int p=0; p < nthreads; ++p)
+        {
+            semiring_mult_rows<Semiring>(ri, ci, vi, part[p], part[p+1], x, y, mask);
+        }
+    }
+
+    /**
+     * y = A^T*x by scattering the rows of A in x.  The indices of y are
+     * in the order they are first reached.
+     */
+    template <class Semiring, class RowIter, class ColIter, class ValIter,
+        class Index, class Value, class Mask>
+    void semiring_spmspv_push(RowIter ri, ColIter ci, ValIter vi, Index nc,
+        const sparse_vector<Index, Value>& x, sparse_vector<Index, Value>& y,
+        spmspv_workspace<Index, Value>& w, const Mask& mask)
+    {
+        typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+
+        w.ymark.resize(nc, 0);
+        w.yval.resize(nc);
+        y.clear();
+
+        for (std::size_t k=0; k < x.size(); ++k)
+        {
+            Index i = x.ind[k];
+            Value xi = x.val[k];
+            for (nzitype cp = ri[i]; cp < ri[i+1]; ++cp)
+            {
+                Index j = ci[cp];
+                if (!mask(j)) { continue; }
+                Value v = Semiring::mult(xi, (Value)vi[cp]);
+                if (w.ymark[j])
+                {
+                    w.yval[j] = Semiring::add(w.yval[j], v);
+                }
+                else
+                {
+                    w.ymark[j] = 1;
+                    w.yval[j] = v;
+                    y.ind.push_back(j);
+                }
+            }
+        }
+
+        y.val.resize(y.ind.size());
+        for (std::size_t k=0; k < y.ind.size(); ++k)
+        {
+            y.val[k] = w.yval[y.ind[k]];
+            w.ymark[y.ind[k]] = 0;
+        }
+    }
+
+    /**
+     * y = A^T*x by gathering each allowed column of A from a dense copy
+     * of x.  The columns are independent, so they run in parallel, and
+     * the indices of y are sorted.
+     */
+    template <class Semiring, class NzSize, class Index, class ValIter,
+        class Value, class Mask>
+    void semiring_spmspv_pull(const NzSize* ati, const Index* atj,
+        const NzSize* atid, ValIter vi, Index nr, Index nc,
+        const sparse_vector<Index, Value>& x, sparse_vector<Index, Value>& y,
+        spmspv_workspace<Index, Value>& w, const Mask& mask)
+    {
+        w.xmark.resize(nr, 0);
+        w.xval.resize(nr);
+        w.ymark.resize(nc, 0);
+        w.yval.resize(nc);
+        for (std::size_t k=0; k < x.size(); ++k)
+        {
+            w.xmark[x.ind[k]] = 1;
+            w.xval[x.ind[k]] = x.val[k];
+        }
+
+        #pragma omp parallel for schedule(dynamic,1024) num_threads(w.nthreads)
+        for (Index j=0; j < nc; ++j)
+        {
+            if (!mask(j)) { continue; }
+            bool found = false;
+            Value yj = Semiring::zero();
+            for (NzSize k = ati[j]; k < ati[j+1]; ++k)
+            {
+                Index i = atj[k];
+                if (!w.xmark[i]) { continue; }
+                yj = Semiring::add(yj, Semiring::mult(w.xval[i], (Value)vi[atid[k]]));
+                found = true;
+            }
+            if (found)
+            {
+                w.ymark[j] = 1;
+                w.yval[j] = yj;
+            }
+        }
+
+        y.clear();
+        for (Index j=0; j < nc; ++j)
+        {
+            if (w.ymark[j])
+            {
+                y.push_back(j, w.yval[j]);
+                w.ymark[j] = 0;
+            }
+        }
+        for (std::size_t k=0; k < x.size(); ++k) { w.xmark[x.ind[k]] = 0; }
+    }
+
+    template <class Semiring, class IndexType, class ValueType, class NzSizeType,
+        class Value, class Mask>
+    void semiring_spmspv(
+        const simple_row_and_column_matrix<IndexType, ValueType, NzSizeType>& m,
+        const sparse_vector<IndexType, Value>& x,
+        sparse_vector<IndexType, Value>& y,
+        spmspv_workspace<IndexType, Value>& w, const Mask& mask)
+    {
+        typedef spmspv_workspace<IndexType, Value> workspace;
+
+        bool pull = (w.direction == workspace::pull_direction);
+        if (w.direction == workspace::auto_direction)
+        {
+            double frontier_nnz = 0.0;
+            for (std::size_t k=0; k < x.size(); ++k)
+            {
+                frontier_nnz += (double)(m.ai[x.ind[k]+1] - m.ai[x.ind[k]]);
+            }
+            pull = frontier_nnz*w.alpha > (double)m.nnz;
+        }
+
+        if (pull)
+        {
+            w.last_direction = workspace::pull_direction;
+            semiring_spmspv_pull<Semiring>((const NzSizeType*)m.ati,
+                (const IndexType*)m.atj, (const NzSizeType*)m.atid,
+                (const ValueType*)m.a, m.nrows, m.ncols, x, y, w, mask);
+        }
+        else
+        {
+            w.last_direction = workspace::push_direction;
+            semiring_spmspv_push<Semiring>((const NzSizeType*)m.ai,
+                (const IndexType*)m.aj, (const ValueType*)m.a,
+                m.ncols, x, y, w, mask);
+        }
+    }
+} // namespace impl
+
+/**
+ * Compute y = A*x over a semiring for a compressed_row_matrix.
+ * RowIter must be a random access iterator.
+ *
+ * Call it as semiring_mult<min_plus_semiring<double> >(m, x, y).
+ *
+ * @param m the matrix A
+ * @param x the input vector, size ncols(m)
+ * @param y the output vector, size nrows(m)
+ * @param nthreads the number of threads
+ */
+template <class Semiring, class RowIter, class ColIter, class ValIter,
+    class Iter1, class Iter2>
+void semiring_mult(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, int nthreads=parallel_max_threads())
+{
+    typedef typename std::iterator_traits<RowIter>::value_type itype;
+    itype nr = nrows(m);
+    impl::parallel_semiring_mult<Semiring>(m._rstart, m._cstart, m._vstart,
+        nr, x, y, impl::semiring_no_mask<itype>(), nthreads);
+}
+
+/**
+ * Compute y = A*x over a semiring for a compressed_row_matrix, only
+ * for the rows r where mask[r] != complement.
+ */
+template <class Semiring, class RowIter, class ColIter, class ValIter,
+    class Iter1, class Iter2, class MaskIter>
+void semiring_mult(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, MaskIter mask, bool complement,
+    int nthreads=parallel_max_threads())
+{
+    typedef typename std::iterator_traits<RowIter>::value_type itype;
+    itype nr = nrows(m);
+    impl::parallel_semiring_mult<Semiring>(m._rstart, m._cstart, m._vstart,
+        nr, x, y, impl::semiring_vector_mask<itype, MaskIter>(mask, complement),
+        nthreads);
+}
+
+/**
+ * Compute y = A*x over a semiring for a simple_csr_matrix (or a
+ * simple_row_and_column_matrix).
+ */
+template <class Semiring, class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void semiring_mult(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, int nthreads=parallel_max_threads())
+{
+    impl::parallel_semiring_mult<Semiring>((const NzSizeType*)m.ai,
+        (const IndexType*)m.aj, (const ValueType*)m.a, m.nrows, x, y,
+        impl::semiring_no_mask<IndexType>(), nthreads);
+}
+
+/**
+ * Compute y = A*x over a semiring for a simple_csr_matrix, only for
+ * the rows r where mask[r] != complement.
+ */
+template <class Semiring, class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2, class MaskIter>
+void semiring_mult(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, MaskIter mask, bool complement,
+    int nthreads=parallel_max_threads())
+{
+    impl::parallel_semiring_mult<Semiring>((const NzSizeType*)m.ai,
+        (const IndexType*)m.aj, (const ValueType*)m.a, m.nrows, x, y,
+        impl::semiring_vector_mask<IndexType, MaskIter>(mask, complement),
+        nthreads);
+}
+
+/**
+ * Compute the sparse y = A^T*x over a semiring for a
+ * compressed_row_matrix.  Without column access this always pushes
+ * along the rows of A in x.
+ *
+ * @param m the matrix A
+ * @param x the sparse input vector, indices less than nrows(m)
+ * @param y the sparse output vector
+ * @param w the workspace
+ */
+template <class Semiring, class RowIter, class ColIter, class ValIter,
+    class Index, class Value>
+void semiring_spmspv(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    const sparse_vector<Index, Value>& x, sparse_vector<Index, Value>& y,
+    spmspv_workspace<Index, Value>& w)
+{
+    Index nc = ncols(m);
+    w.last_direction = spmspv_workspace<Index, Value>::push_direction;
+    impl::semiring_spmspv_push<Semiring>(m._rstart, m._cstart, m._vstart,
+        nc, x, y, w, impl::semiring_no_mask<Index>());
+}
+
+/**
+ * Compute the sparse y = A^T*x over a semiring for a
+ * compressed_row_matrix, only for the entries j where
+ * mask[j] != complement.
+ */
+template <class Semiring, class RowIter, class ColIter, class ValIter,
+    class Index, class Value, class MaskIter>
+void semiring_spmspv(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    const sparse_vector<Index, Value>& x, sparse_vector<Index, Value>& y,
+    spmspv_workspace<Index, Value>& w, MaskIter mask, bool complement)
+{
+    Index nc = ncols(m);
+    w.last_direction = spmspv_workspace<Index, Value>::push_direction;
+    impl::semiring_spmspv_push<Semiring>(m._rstart, m._cstart, m._vstart,
+        nc, x, y, w, impl::semiring_vector_mask<Index, MaskIter>(mask, complement));
+}
+
+/**
+ * Compute the sparse y = A^T*x over a semiring for a
+ * simple_row_and_column_matrix.  The direction is picked by the
+ * workspace, see spmspv_workspace.
+ *
+ * @param m the matrix A
+ * @param x the sparse input vector, indices less than nrows(m)
+ * @param y the sparse output vector
+ * @param w the workspace
+ */
+template <class Semiring, class IndexType, class ValueType, class NzSizeType,
+    class Value>
+void semiring_spmspv(
+    const simple_row_and_column_matrix<IndexType, ValueType, NzSizeType>& m,
+    const sparse_vector<IndexType, Value>& x, sparse_vector<IndexType, Value>& y,
+    spmspv_workspace<IndexType, Value>& w)
+{
+    impl::semiring_spmspv<Semiring>(m, x, y, w,
+        impl::semiring_no_mask<IndexType>());
+}
+
+/**
+ * Compute the sparse y = A^T*x over a semiring for a
+ * simple_row_and_column_matrix, only for the entries j where
+ * mask[j] != complement.
+ */
+template <class Semiring, class IndexType, class ValueType, class NzSizeType,
+    class Value, class MaskIter>
+void semiring_spmspv(
+    const simple_row_and_column_matrix<IndexType, ValueType, NzSizeType>& m,
+    const sparse_vector<IndexType, Value>& x, sparse_vector<IndexType, Value>& y,
+    spmspv_workspace<IndexType, Value>& w, MaskIter mask, bool complement)
+{
+    impl::semiring_spmspv<Semiring>(m, x, y, w,
+        impl::semiring_vector_mask<IndexType, MaskIter>(mask, complement));
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_SEMIRING_OPERATIONS_HPP
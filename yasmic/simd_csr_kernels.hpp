@@ -0,0 +1,419 @@
+#ifndef YASMIC_SIMD_CSR_KERNELS_HPP
+#define YASMIC_SIMD_CSR_KERNELS_HPP
+
+/**
+ * @file simd_csr_kernels.hpp
+ * Explicitly vectorized y = A*x kernels for simple_csr_matrix<int,double>
+ * and simple_csr_matrix<int,float>.
+ *
+ * There are three versions of each kernel: a scalar loop with four
+ * independent accumulators, an AVX2 loop that gathers x with two vector
+ * accumulators and a masked tail for the end of each row, and an AVX-512
+ * loop with the same structure.  The version is picked at runtime from
+ * the CPUID flags, so a single binary runs everywhere.
+ *
+ * The vector kernels sum the products of a row in a different order
+ * than mult, so the results may differ from mult by rounding.
+ *
+ * Define YASMIC_NO_SIMD to compile only the scalar kernels.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+
+#include <yasmic/simple_csr_matrix.hpp>
+#include <yasmic/parallel_util.hpp>
+
+#ifndef YASMIC_NO_SIMD
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #define YASMIC_SIMD_X86
+        #define YASMIC_SIMD_TARGET(isa) __attribute__((target(isa)))
+        #include <immintrin.h>
+    #elif defined(_MSC_VER) && _MSC_VER >= 1900 && (defined(_M_X64) || defined(_M_IX86))
+        #define YASMIC_SIMD_X86
+        #define YASMIC_SIMD_TARGET(isa)
+        #include <immintrin.h>
+        #include <intrin.h>
+    #endif
+#endif // YASMIC_NO_SIMD
+
+namespace yasmic
+{
+
+/**
+ * The instruction set levels for the vectorized kernels.
+ */
+enum simd_level
+{
+    simd_scalar = 0,
+    simd_avx2 = 1,
+    simd_avx512 = 2
+};
+
+namespace impl
+{
+    inline simd_level simd_detect_level_uncached()
+    {
+#if defined(YASMIC_SIMD_X86) && defined(__GNUC__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) { return simd_avx512; }
+        if (__builtin_cpu_supports("avx2")) { return simd_avx2; }
+        return simd_scalar;
+#elif defined(YASMIC_SIMD_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) { return simd_scalar; }
+        __cpuid(info, 1);
+        // the OS must save the ymm registers (OSXSAVE and XCR0)
+        if (!(info[2] & (1 << 27))) { return simd_scalar; }
+        unsigned long long xcr0 = _xgetbv(0);
+        if ((xcr0 & 0x6) != 0x6) { return simd_scalar; }
+        __cpuid(info, 7);
+        if ((info[1] & (1 << 16)) && (xcr0 & 0xe6) == 0xe6) { return simd_avx512; }
+        if (info[1] & (1 << 5)) { return simd_avx2; }
+        return simd_scalar;
+#else
+        return simd_scalar;
+#endif
+    }
+}
+
+/**
+ * Return the best instruction set level supported by this processor.
+ * The CPUID check only happens on the first call.
+ */
+inline simd_level simd_detect_level()
+{
+    static simd_level level = impl::simd_detect_level_uncached();
+    return level;
+}
+
+namespace impl
+{
+    /**
+     * The scalar kernel, with four accumulators to break the
+     * dependency chain on the sum.
+     */
+    template <class Value>
+    inline void csr_mult_rows_scalar(const int* ai, const int* aj,
+        const Value* a, int rstart, int rend, const Value* x, Value* y)
+    {
+        for (int r=rstart; r < rend; ++r)
+        {
+            int cp = ai[r], cpend = ai[r+1];
+            Value ip0 = 0, ip1 = 0, ip2 = 0, ip3 = 0;
+            for (; cp+4 <= cpend; cp += 4)
+            {
+                ip0 += a[cp]*x[aj[cp]];
+                ip1 += a[cp+1]*x[aj[cp+1]];
+                ip2 += a[cp+2]*x[aj[cp+2]];
+                ip3 += a[cp+3]*x[aj[cp+3]];
+            }
+            for (; cp < cpend; ++cp)
+            {
+                ip0 += a[cp]*x[aj[cp]];
+            }
+            y[r] = (ip0 + ip1) + (ip2 + ip3);
+        }
+    }
+
+#ifdef YASMIC_SIMD_X86
+
+    YASMIC_SIMD_TARGET("avx2")
+    inline void csr_mult_rows_avx2(const int* ai, const int* aj,
+        const double* a, int rstart, int rend, const double* x, double* y)
+    {
+        const __m128i lanes4 = _mm_setr_epi32(0,1,2,3);
+        const __m256i lanes4x64 = _mm256_setr_epi64x(0,1,2,3);
+        const __m256d all4 = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (int r=rstart; r < rend; ++r)
+        {
+            int cp = ai[r], cpend = ai[r+1];
+            __m256d acc0 = _mm256_setzero_pd();
+            __m256d acc1 = _mm256_setzero_pd();
+            for (; cp+8 <= cpend; cp += 8)
+            {
+                __m128i j0 = _mm_loadu_si128((const __m128i*)(aj+cp));
+                __m128i j1 = _mm_loadu_si128((const __m128i*)(aj+cp+4));
+                acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(
+                    _mm256_loadu_pd(a+cp),
+                    _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, j0, all4, 8)));
+                acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(
+                    _mm256_loadu_pd(a+cp+4),
+                    _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, j1, all4, 8)));
+            }
+            if (cp+4 <= cpend)
+            {
+                __m128i j0 = _mm_loadu_si128((const __m128i*)(aj+cp));
+                acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(
+                    _mm256_loadu_pd(a+cp),
+                    _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, j0, all4, 8)));
+                cp += 4;
+            }
+            if (cp < cpend)
+            {
+                // masked tail with the remaining 1-3 entries
+                int rem = cpend - cp;
+                __m128i jmask = _mm_cmpgt_epi32(_mm_set1_epi32(rem), lanes4);
+                __m256i vmask = _mm256_cmpgt_epi64(
+                    _mm256_set1_epi64x(rem), lanes4x64);
+                __m128i j0 = _mm_maskload_epi32(aj+cp, jmask);
+                __m256d xv = _mm256_mask_i32gather_pd(_mm256_setzero_pd(),
+                    x, j0, _mm256_castsi256_pd(vmask), 8);
+                acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(
+                    _mm256_maskload_pd(a+cp, vmask), xv));
+            }
+            __m256d acc = _mm256_add_pd(acc0, acc1);
+            __m128d s = _mm_add_pd(_mm256_castpd256_pd128(acc),
+                _mm256_extractf128_pd(acc, 1));
+            s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+            y[r] = _mm_cvtsd_f64(s);
+        }
+    }
+
+    YASMIC_SIMD_TARGET("avx2")
+    inline void csr_mult_rows_avx2(const int* ai, const int* aj,
+        const float* a, int rstart, int rend, const float* x, float* y)
+    {
+        const __m256i lanes8 = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+        const __m256 all8 = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int r=rstart; r < rend; ++r)
+        {
+            int cp = ai[r], cpend = ai[r+1];
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
+            for (; cp+16 <= cpend; cp += 16)
+            {
+                __m256i j0 = _mm256_loadu_si256((const __m256i*)(aj+cp));
+                __m256i j1 = _mm256_loadu_si256((const __m256i*)(aj+cp+8));
+                acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(
+                    _mm256_loadu_ps(a+cp),
+                    _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, j0, all8, 4)));
+                acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(
+                    _mm256_loadu_ps(a+cp+8),
+                    _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, j1, all8, 4)));
+            }
+            if (cp+8 <= cpend)
+            {
+                __m256i j0 = _mm256_loadu_si256((const __m256i*)(aj+cp));
+                acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(
+                    _mm256_loadu_ps(a+cp),
+                    _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, j0, all8, 4)));
+                cp += 8;
+            }
+            if (cp < cpend)
+            {
+                // masked tail with the remaining 1-7 entries
+                __m256i mask = _mm256_cmpgt_epi32(
+                    _mm256_set1_epi32(cpend - cp), lanes8);
+                __m256i j0 = _mm256_maskload_epi32(aj+cp, mask);
+                __m256 xv = _mm256_mask_i32gather_ps(_mm256_setzero_ps(),
+                    x, j0, _mm256_castsi256_ps(mask), 4);
+                acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(
+                    _mm256_maskload_ps(a+cp, mask), xv));
+            }
+            __m256 acc = _mm256_add_ps(acc0, acc1);
+            __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc),
+                _mm256_extractf128_ps(acc, 1));
+            s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+            s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+            y[r] = _mm_cvtss_f32(s);
+        }
+    }
+
+    /*
+     * The sum of the lanes.  _mm512_reduce_add and the 512 to 256 bit
+     * casts start from an undefined register, so take both halves with
+     * a masked extract from zero.
+     */
+    YASMIC_SIMD_TARGET("avx512f")
+    inline double hsum_avx512(__m512d v)
+    {
+        __m256d h = _mm256_add_pd(
+            _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xff, v, 0),
+            _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xff, v, 1));
+        __m128d s = _mm_add_pd(_mm256_castpd256_pd128(h),
+            _mm256_extractf128_pd(h, 1));
+        s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+        return (_mm_cvtsd_f64(s));
+    }
+
+    YASMIC_SIMD_TARGET("avx512f")
+    inline float hsum_avx512(__m512 v)
+    {
+        __m512d vd = _mm512_castps_pd(v);
+        __m256 h = _mm256_add_ps(
+            _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(
+                _mm256_setzero_pd(), 0xff, vd, 0)),
+            _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(
+                _mm256_setzero_pd(), 0xff, vd, 1)));
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(h),
+            _mm256_extractf128_ps(h, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+        return (_mm_cvtss_f32(s));
+    }
+
+    YASMIC_SIMD_TARGET("avx512f")
+    inline void csr_mult_rows_avx512(const int* ai, const int* aj,
+        const double* a, int rstart, int rend, const double* x, double* y)
+    {
+        const __m256i lanes8 = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+        for (int r=rstart; r < rend; ++r)
+        {
+            int cp = ai[r], cpend = ai[r+1];
+            __m512d acc0 = _mm512_setzero_pd();
+            __m512d acc1 = _mm512_setzero_pd();
+            for (; cp+16 <= cpend; cp += 16)
+            {
+                __m256i j0 = _mm256_loadu_si256((const __m256i*)(aj+cp));
+                __m256i j1 = _mm256_loadu_si256((const __m256i*)(aj+cp+8));
+                acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(
+                    _mm512_loadu_pd(a+cp),
+                    _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, j0, x, 8)));
+                acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(
+                    _mm512_loadu_pd(a+cp+8),
+                    _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, j1, x, 8)));
+            }
+            if (cp < cpend)
+            {
+                // masked tail with the remaining 1-15 entries
+                int rem = cpend - cp;
+                __mmask8 m0 = (__mmask8)(rem >= 8 ? 0xff : (1u << rem) - 1);
+                __m256i j0 = _mm256_maskload_epi32(aj+cp,
+                    _mm256_cmpgt_epi32(_mm256_set1_epi32(rem), lanes8));
+                acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(
+                    _mm512_maskz_loadu_pd(m0, a+cp),
+                    _mm512_mask_i32gather_pd(_mm512_setzero_pd(), m0, j0, x, 8)));
+                if (rem > 8)
+                {
+                    __mmask8 m1 = (__mmask8)((1u << (rem-8)) - 1);
+                    __m256i j1 = _mm256_maskload_epi32(aj+cp+8,
+                        _mm256_cmpgt_epi32(_mm256_set1_epi32(rem-8), lanes8));
+                    acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(
+                        _mm512_maskz_loadu_pd(m1, a+cp+8),
+                        _mm512_mask_i32gather_pd(_mm512_setzero_pd(), m1, j1, x, 8)));
+                }
+            }
+            y[r] = hsum_avx512(_mm512_add_pd(acc0, acc1));
+        }
+    }
+
+    YASMIC_SIMD_TARGET("avx512f")
+    inline void csr_mult_rows_avx512(const int* ai, const int* aj,
+        const float* a, int rstart, int rend, const float* x, float* y)
+    {
+        for (int r=rstart; r < rend; ++r)
+        {
+            int cp = ai[r], cpend = ai[r+1];
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 acc1 = _mm512_setzero_ps();
+            for (; cp+32 <= cpend; cp += 32)
+            {
+                __m512i j0 = _mm512_loadu_si512((const void*)(aj+cp));
+                __m512i j1 = _mm512_loadu_si512((const void*)(aj+cp+16));
+                acc0 = _mm512_add_ps(acc0, _mm512_mul_ps(
+                    _mm512_loadu_ps(a+cp),
+                    _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xffff, j0, x, 4)));
+                acc1 = _mm512_add_ps(acc1, _mm512_mul_ps(
+                    _mm512_loadu_ps(a+cp+16),
+                    _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xffff, j1, x, 4)));
+            }
+            while (cp < cpend)
+            {
+                // masked tail, at most two passes
+                int rem = cpend - cp;
+                __mmask16 m = (__mmask16)(rem >= 16 ? 0xffff : (1u << rem) - 1);
+                __m512i j0 = _mm512_maskz_loadu_epi32(m, aj+cp);
+                acc0 = _mm512_add_ps(acc0, _mm512_mul_ps(
+                    _mm512_maskz_loadu_ps(m, a+cp),
+                    _mm512_mask_i32gather_ps(_mm512_setzero_ps(), m, j0, x, 4)));
+                cp += 16;
+            }
+            y[r] = hsum_avx512(_mm512_add_ps(acc0, acc1));
+        }
+    }
+
+#endif // YASMIC_SIMD_X86
+
+    /**
+     * Pick the kernel for a range of rows.  Only double and float
+     * have vectorized versions.
+     */
+    template <class Value>
+    inline void csr_mult_rows_simd(simd_level level, const int* ai,
+        const int* aj, const Value* a, int rstart, int rend,
+        const Value* x, Value* y)
+    {
+#ifdef YASMIC_SIMD_X86
+        if (level >= simd_avx512)
+        {
+            csr_mult_rows_avx512(ai, aj, a, rstart, rend, x, y);
+            return;
+        }
+        if (level >= simd_avx2)
+        {
+            csr_mult_rows_avx2(ai, aj, a, rstart, rend, x, y);
+            return;
+        }
+#endif // YASMIC_SIMD_X86
+        csr_mult_rows_scalar(ai, aj, a, rstart, rend, x, y);
+    }
+} // namespace impl
+
+/**
+ * Compute y = A*x with the vectorized kernels.
+ *
+ * @param m the matrix A, a simple_csr_matrix<int,double> or
+ *   simple_csr_matrix<int,float>
+ * @param x the input vector, size ncols(m)
+ * @param y the output vector, size nrows(m)
+ * @param nthreads the number of threads, the rows are split with
+ *   nnz_balanced_row_partition
+ * @param level the instruction set to use, this is reduced to what
+ *   the processor supports
+ */
+template <class Value>
+void simd_mult(const simple_csr_matrix<int,Value,int>& m,
+    const Value* x, Value* y, int nthreads, simd_level level)
+{
+    if (level > simd_detect_level()) { level = simd_detect_level(); }
+    if (nthreads < 1) { nthreads = 1; }
+    if (nthreads == 1)
+    {
+        impl::csr_mult_rows_simd(level, m.ai, m.aj, m.a, 0, m.nrows, x, y);
+        return;
+    }
+
+    std::vector<int> part(nthreads+1);
+    nnz_balanced_row_partition(m.ai, m.nrows, nthreads, part.begin());
+
+    #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+    for (int p=0; p < nthreads; ++p)
+    {
+        impl::csr_mult_rows_simd(level, m.ai, m.aj, m.a,
+            part[p], part[p+1], x, y);
+    }
+}
+
+template <class Value>
+void simd_mult(const simple_csr_matrix<int,Value,int>& m,
+    const Value* x, Value* y, int nthreads)
+{
+    simd_mult(m, x, y, nthreads, simd_detect_level());
+}
+
+template <class Value>
+void simd_mult(const simple_csr_matrix<int,Value,int>& m,
+    const Value* x, Value* y)
+{
+    simd_mult(m, x, y, 1, simd_detect_level());
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_SIMD_CSR_KERNELS_HPP
@@ -22,6 +22,9 @@
  * 
  * 29 August 2007
  * Removed big commented section
+ *
+ * 19 October 2026
+ * Added mult and trans_mult
  */
 
 #include <yasmic/smatrix_traits.hpp>
@@ -97,6 +100,83 @@ template <class IndexType, class ValueType, class NzSizeType>
 NzSizeType nnz(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m)
 { return m.nnz; }
 
+/**
+ * Compute y = A*x for a simple_csr_matrix.
+ *
+ * @param m the matrix A
+ * @param x the input vector, size ncols(m)
+ * @param y the output vector, size nrows(m)
+ */
+template <class IndexType, class ValueType, class NzSizeType, 
+    class Iter1, class Iter2>
+void mult(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m, 
+    Iter1 x, Iter2 y)
+{
+    const NzSizeType *ai = m.ai;
+    const IndexType *aj = m.aj;
+    const ValueType *a = m.a;
+
+    for (IndexType r=0; r < m.nrows; ++r)
+    {
+        ValueType ip = ValueType();
+        for (NzSizeType cp = ai[r]; cp < ai[r+1]; ++cp)
+        {
+            ip += a[cp]*x[aj[cp]];
+        }
+        y[r] = ip;
+    }
+}
+
+/**
+ * Compute y = A^T*x for a simple_csr_matrix.
+ *
+ * @param m the matrix A
+ * @param x the input vector, size nrows(m)
+ * @param y the output vector, size ncols(m)
+ */
+template <class IndexType, class ValueType, class NzSizeType, 
+    class Iter1, class Iter2>
+void trans_mult(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m, 
+    Iter1 x, Iter2 y)
+{
+    const NzSizeType *ai = m.ai;
+    const IndexType *aj = m.aj;
+    const ValueType *a = m.a;
+
+    for (IndexType c=0; c < m.ncols; ++c) { y[c] = ValueType(); }
+
+    for (IndexType r=0; r < m.nrows; ++r)
+    {
+        ValueType xv = x[r];
+        for (NzSizeType cp = ai[r]; cp < ai[r+1]; ++cp)
+        {
+            y[aj[cp]] += a[cp]*xv;
+        }
+    }
+}
+
+
+/*
+ * These overloads are required so that a non-const matrix does not 
+ * select the nonzero iterator version of mult and trans_mult in 
+ * generic_matrix_operations.hpp.
+ */
+template <class IndexType, class ValueType, class NzSizeType, 
+    class Iter1, class Iter2>
+void mult(simple_csr_matrix<IndexType, ValueType, NzSizeType>& m, 
+    Iter1 x, Iter2 y)
+{
+    mult((const simple_csr_matrix<IndexType, ValueType, NzSizeType>&)m, x, y);
+}
+
+template <class IndexType, class ValueType, class NzSizeType, 
+    class Iter1, class Iter2>
+void trans_mult(simple_csr_matrix<IndexType, ValueType, NzSizeType>& m, 
+    Iter1 x, Iter2 y)
+{
+    trans_mult((const simple_csr_matrix<IndexType, ValueType, NzSizeType>&)m,
+        x, y);
+}
 
 } // namespace yasmic
 
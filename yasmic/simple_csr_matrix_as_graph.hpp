@@ -23,6 +23,11 @@
  * 29 August 2007
  * Added get function for edge_index_property_map to the boost::detail 
  * namespace to fix a compile bug on g++-4.1
+ *
+ * 19 October 2026
+ * Fixed adjacent_vertices to index aj through the row pointers
+ * Stop the edge_iterator at the last edge instead of reading past the
+ * row pointers
  */
 
 #include <yasmic/simple_csr_matrix.hpp>
@@ -88,13 +93,13 @@ public:
     // required due to "bug" in InputIterator concept, it is unused
     typedef typename boost::int_t<CHAR_BIT * sizeof(EdgeIndex)>::fast difference_type;
    
-    simple_csr_edge_iterator() : ai(NULL), current_edge(), end_of_this_vertex(0) {}
+    simple_csr_edge_iterator() : ai(NULL), nnz(0), current_edge(), end_of_this_vertex(0) {}
 
     simple_csr_edge_iterator(
                 const YASMIC_SIMPLE_CSR_GRAPH_TYPE& g,
                 value_type current_edge,
                 EdgeIndex end_of_this_vertex)
-    : ai(g.ai), current_edge(current_edge),
+    : ai(g.ai), nnz(g.nnz), current_edge(current_edge),
       end_of_this_vertex(end_of_this_vertex) {}
 
     // From InputIterator
@@ -110,7 +115,7 @@ public:
 
     simple_csr_edge_iterator& operator++() {
         ++current_edge.i;
-        while (current_edge.i == end_of_this_vertex) {
+        while (current_edge.i == end_of_this_vertex && current_edge.i != nnz) {
             ++current_edge.r;
             end_of_this_vertex = ai[current_edge.r + 1];
         }
@@ -124,6 +129,7 @@ public:
     }
 private:
     const EdgeIndex* ai;
+    EdgeIndex nnz;
     value_type current_edge;
     EdgeIndex end_of_this_vertex;
 };
@@ -278,7 +284,7 @@ namespace boost {
     inline std::pair< typename graph_traits<YASMIC_SIMPLE_CSR_GRAPH_TYPE>::adjacency_iterator,
                       typename graph_traits<YASMIC_SIMPLE_CSR_GRAPH_TYPE>::adjacency_iterator >
         adjacent_vertices(Index v, const YASMIC_SIMPLE_CSR_GRAPH_TYPE& g) { 
-            return std::make_pair(&g.aj[v],&g.aj[v+1]);
+            return std::make_pair(&g.aj[g.ai[v]],&g.aj[g.ai[v+1]]);
     }
     //
     // implement the functions for property maps
@@ -0,0 +1,126 @@
+#ifndef YASMIC_SPARSE_MAP_HPP
+#define YASMIC_SPARSE_MAP_HPP
+
+/**
+ * @file sparse_map.hpp
+ * A map from integer keys to values for the local graph algorithms,
+ * where the number of keys touched is much smaller than the graph.
+ *
+ * The keys and values are kept in insertion order in two arrays, and an
+ * open addressing hash table with linear probing maps a key to its
+ * position.  Nothing is ever erased, so clear only resets the slots of
+ * the keys that were used, and the cost of a query is independent of
+ * the size of the graph.  The memory is kept over clear so the map can
+ * be reused for many queries.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace yasmic
+{
+
+template <class Key, class Value>
+class sparse_map
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+
+    sparse_map() : _slots(16, npos()) {}
+
+    /** The value of key k, inserting a zero value if it is not there. */
+    Value& operator[](Key k)
+    {
+        std::size_t s = find(k);
+        if (_slots[s] == npos())
+        {
+            if (2*(_keys.size()+1) > _slots.size())
+            {
+                grow();
+                s = find(k);
+            }
+            _slots[s] = _keys.size();
+            _keys.push_back(k);
+            _vals.push_back(Value());
+        }
+        return (_vals[_slots[s]]);
+    }
+
+    /** The value of key k, or zero if it is not there. */
+    Value get(Key k) const
+    {
+        std::size_t s = find(k);
+        return (_slots[s] == npos() ? Value() : _vals[_slots[s]]);
+    }
+
+    bool contains(Key k) const
+    {
+        return (_slots[find(k)] != npos());
+    }
+
+    /** The number of keys, they are numbered in insertion order. */
+    std::size_t size() const { return (_keys.size()); }
+    bool empty() const { return (_keys.empty()); }
+
+    Key key(std::size_t i) const { return (_keys[i]); }
+    Value value(std::size_t i) const { return (_vals[i]); }
+    Value& value(std::size_t i) { return (_vals[i]); }
+
+    /**
+     * Remove all the keys in time proportional to their number.  A key
+     * only probes past the slots of keys inserted before it, so the
+     * slots are reset in the reverse order of insertion.
+     */
+    void clear()
+    {
+        if (4*_keys.size() < _slots.size())
+        {
+            for (std::size_t i=_keys.size(); i > 0; --i)
+            {
+                _slots[find(_keys[i-1])] = npos();
+            }
+        }
+        else
+        {
+            std::fill(_slots.begin(), _slots.end(), npos());
+        }
+        _keys.clear();
+        _vals.clear();
+    }
+
+private:
+    static std::size_t npos() { return ((std::size_t)-1); }
+
+    std::size_t find(Key k) const
+    {
+        std::size_t mask = _slots.size()-1;
+        std::size_t h = ((std::size_t)k*2654435761u) & mask;
+        while (_slots[h] != npos() && _keys[_slots[h]] != k) { h = (h+1) & mask; }
+        return (h);
+    }
+
+    void grow()
+    {
+        _slots.assign(2*_slots.size(), npos());
+        for (std::size_t i=0; i < _keys.size(); ++i)
+        {
+            _slots[find(_keys[i])] = i;
+        }
+    }
+
+    // the position of the key in each slot, the size is a power of two
+    std::vector<std::size_t> _slots;
+    std::vector<Key> _keys;
+    std::vector<Value> _vals;
+};
+
+} // namespace yasmic
+
+#endif // YASMIC_SPARSE_MAP_HPP
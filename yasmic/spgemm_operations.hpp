@@ -0,0 +1,441 @@
+#ifndef YASMIC_SPGEMM_OPERATIONS_HPP
+#define YASMIC_SPGEMM_OPERATIONS_HPP
+
+/**
+ * @file spgemm_operations.hpp
+ * Sparse matrix times sparse matrix, C = A*B, with Gustavson's row by
+ * row algorithm: row i of C is the sum of the rows B(k,:) scaled by
+ * A(i,k).
+ *
+ * The product runs in two passes over the rows.  The symbolic pass
+ * counts the nonzeros in each row of C from the patterns alone, so the
+ * output is allocated exactly once, and the numeric pass fills it in.  Each row is summed
+ * in an accumulator chosen from its flop count (the number of products
+ * nnz(B(k,:)) summed over the row of A): a dense array of ncols(B)
+ * entries for rows with many products, and a small hash table for the
+ * rest.  The rows are split among threads so each gets about the same
+ * number of flops.
+ *
+ * An optional mask M restricts the output to the pattern of M, that is
+ * C = (A*B) .* spones(M), without forming the entries outside of M.
+ * The columns of each row of C are sorted by default, unsorted output
+ * skips the sort.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    /**
+     * The per thread accumulator for one row of C.  The state of a
+     * column is 0 for untouched, 1 when it is in the mask but not yet
+     * in the product, and 2 when it is in the product.
+     */
+    template <class Index, class Value>
+    struct spgemm_accumulator
+    {
+        Index ncols;
+
+        // the dense accumulator, allocated on the first dense row
+        std::vector<char> dstate;
+        std::vector<Value> dval;
+
+        // the hash accumulator, the capacity is a power of two
+        std::vector<Index> hkey;
+        std::vector<char> hstate;
+        std::vector<Value> hval;
+        std::size_t hcap;
+
+        bool dense;
+        // the columns in the product, for the dense accumulator
+        std::vector<Index> cols;
+        std::size_t count;
+
+        std::vector< std::pair<Index, Value> > sorted;
+
+        spgemm_accumulator(Index ncols) : ncols(ncols), hcap(0), dense(false), count(0) {}
+
+        void begin_row(std::size_t size)
+        {
+            count = 0;
+            dense = size*16 > (std::size_t)ncols;
+            if (dense)
+            {
+                if (dstate.empty())
+                {
+                    dstate.assign(ncols, 0);
+                    dval.resize(ncols);
+                }
+                cols.clear();
+            }
+            else
+            {
+                hcap = 16;
+                while (hcap < 2*size) { hcap *= 2; }
+                if (hkey.size() < hcap)
+                {
+                    hkey.resize(hcap);
+                    hstate.resize(hcap);
+                    hval.resize(hcap);
+                }
+                std::fill(hstate.begin(), hstate.begin()+hcap, 0);
+            }
+        }
+
+        std::size_t find(Index c)
+        {
+            std::size_t h = ((std::size_t)c*2654435761u) & (hcap-1);
+            while (hstate[h] != 0 && hkey[h] != c) { h = (h+1) & (hcap-1); }
+            return (h);
+        }
+
+        /** Add column c to the mask for this row. */
+        void allow(Index c)
+        {
+            if (dense) { dstate[c] = 1; return; }
+            std::size_t h = find(c);
+            hkey[h] = c;
+            hstate[h] = 1;
+        }
+
+        /** Add v to column c, when masked only columns in the mask count. */
+        void add(Index c, Value v, bool masked)
+        {
+            char* s;
+            Value* x;
+            if (dense)
+            {
+                s = &dstate[c];
+                x = &dval[c];
+            }
+            else
+            {
+                std::size_t h = find(c);
+                if (hstate[h] == 0) { hkey[h] = c; }
+                s = &hstate[h];
+                x = &hval[h];
+            }
+
+            if (*s == 2) { *x += v; return; }
+            if (masked && *s != 1) { return; }
+            *s = 2;
+            *x = v;
+            ++count;
+            if (dense) { cols.push_back(c); }
+        }
+
+        /** Add column c to the product without a value, for counting. */
+        void mark(Index c, bool masked)
+        {
+            char* s;
+            if (dense)
+            {
+                s = &dstate[c];
+            }
+            else
+            {
+                std::size_t h = find(c);
+                if (hstate[h] == 0) { hkey[h] = c; }
+                s = &hstate[h];
+            }
+
+            if (*s == 2 || (masked && *s != 1)) { return; }
+            *s = 2;
+            ++count;
+            if (dense) { cols.push_back(c); }
+        }
+
+        /**
+         * Write the row to cj and cv and reset the dense state, the
+         * mask columns are reset with unallow.
+         */
+        template <class ColIter, class ValIter>
+        void collect(ColIter cj, ValIter cv, bool sort_columns)
+        {
+            if (dense)
+            {
+                if (sort_columns) { std::sort(cols.begin(), cols.end()); }
+                for (std::size_t k=0; k < cols.size(); ++k)
+                {
+                    Index c = cols[k];
+                    cj[k] = c;
+                    cv[k] = dval[c];
+                    dstate[c] = 0;
+                }
+                return;
+            }
+
+            sorted.clear();
+            for (std::size_t h=0; h < hcap; ++h)
+            {
+                if (hstate[h] == 2) { sorted.push_back(std::make_pair(hkey[h], hval[h])); }
+            }
+            if (sort_columns) { std::sort(sorted.begin(), sorted.end()); }
+            for (std::size_t k=0; k < sorted.size(); ++k)
+            {
+                cj[k] = sorted[k].first;
+                cv[k] = sorted[k].second;
+            }
+        }
+
+        /** Reset the dense state without writing the row. */
+        void clear()
+        {
+            if (dense)
+            {
+                for (std::size_t k=0; k < cols.size(); ++k) { dstate[cols[k]] = 0; }
+            }
+        }
+
+        void unallow(Index c)
+        {
+            if (dense) { dstate[c] = 0; }
+        }
+    };
+
+    /**
+     * Compute row i of A*B in the accumulator.  Without numeric only the
+     * columns are found, and the values of A and B are not read.
+     */
+    template <class ARowIter, class AColIter, class AValIter,
+        class BRowIter, class BColIter, class BValIter,
+        class MRowIter, class MColIter, class Index, class Value>
+    void spgemm_row(Index i,
+        ARowIter ari, AColIter aci, AValIter avi,
+        BRowIter bri, BColIter bci, BValIter bvi,
+        bool masked, MRowIter mri, MColIter mci,
+        std::size_t flops, bool numeric, spgemm_accumulator<Index, Value>& acc)
+    {
+        typedef typename std::iterator_traits<ARowIter>::value_type anztype;
+        typedef typename std::iterator_traits<BRowIter>::value_type bnztype;
+        typedef typename std::iterator_traits<MRowIter>::value_type mnztype;
+
+        if (masked)
+        {
+            // the mask columns are all in the hash table
+            acc.begin_row((std::size_t)(mri[i+1] - mri[i]));
+            for (mnztype mp = mri[i]; mp < mri[i+1]; ++mp) { acc.allow(mci[mp]); }
+        }
+        else
+        {
+            acc.begin_row(std::min(flops, (std::size_t)acc.ncols));
+        }
+
+        for (anztype ap = ari[i]; ap < ari[i+1]; ++ap)
+        {
+            Index k = aci[ap];
+            if (!numeric)
+            {
+                for (bnztype bp = bri[k]; bp < bri[k+1]; ++bp)
+                {
+                    acc.mark(bci[bp], masked);
+                }
+                continue;
+            }
+            Value av = avi[ap];
+            for (bnztype bp = bri[k]; bp < bri[k+1]; ++bp)
+            {
+                acc.add(bci[bp], av*bvi[bp], masked);
+            }
+        }
+    }
+
+    template <class ARowIter, class AColIter, class AValIter,
+        class BRowIter, class BColIter, class BValIter,
+        class MRowIter, class MColIter,
+        class Index, class NzSize, class Value>
+    void spgemm(Index nr, Index nc,
+        ARowIter ari, AColIter aci, AValIter avi,
+        BRowIter bri, BColIter bci, BValIter bvi,
+        bool masked, MRowIter mri, MColIter mci,
+        std::vector<NzSize>& ci, std::vector<Index>& cj, std::vector<Value>& cv,
+        bool sort_columns, int nthreads)
+    {
+        typedef typename std::iterator_traits<ARowIter>::value_type anztype;
+        typedef typename std::iterator_traits<MRowIter>::value_type mnztype;
+
+        if (nthreads < 1) { nthreads = 1; }
+
+        // the cumulative flops, to balance the rows among threads
+        std::vector<std::size_t> flops(nr+1);
+        flops[0] = 0;
+        for (Index i=0; i < nr; ++i)
+        {
+            std::size_t f = 0;
+            for (anztype ap = ari[i]; ap < ari[i+1]; ++ap)
+            {
+                f += (std::size_t)(bri[aci[ap]+1] - bri[aci[ap]]);
+            }
+            flops[i+1] = flops[i] + f;
+        }
+
+        std::vector<Index> part(nthreads+1);
+        nnz_balanced_row_partition(flops.begin(), nr, nthreads, part.begin());
+
+        ci.assign(nr+1, 0);
+
+        // the symbolic pass, count the nonzeros in each row
+        #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+        for (int p=0; p < nthreads; ++p)
+        {
+            spgemm_accumulator<Index, Value> acc(nc);
+            for (Index i=part[p]; i < part[p+1]; ++i)
+            {
+                spgemm_row(i, ari, aci, avi, bri, bci, bvi, masked, mri, mci,
+                    flops[i+1] - flops[i], false, acc);
+                ci[i+1] = (NzSize)acc.count;
+                acc.clear();
+                if (masked)
+                {
+                    for (mnztype mp = mri[i]; mp < mri[i+1]; ++mp) { acc.unallow(mci[mp]); }
+                }
+            }
+        }
+
+        for (Index i=0; i < nr; ++i) { ci[i+1] += ci[i]; }
+        cj.resize(ci[nr]);
+        cv.resize(ci[nr]);
+
+        // the numeric pass
+        #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+        for (int p=0; p < nthreads; ++p)
+        {
+            spgemm_accumulator<Index, Value> acc(nc);
+            for (Index i=part[p]; i < part[p+1]; ++i)
+            {
+                spgemm_row(i, ari, aci, avi, bri, bci, bvi, masked, mri, mci,
+                    flops[i+1] - flops[i], true, acc);
+                if (ci[i+1] > ci[i])
+                {
+                    acc.collect(&cj[ci[i]], &cv[ci[i]], sort_columns);
+                }
+                else
+                {
+                    acc.clear();
+                }
+                if (masked)
+                {
+                    for (mnztype mp = mri[i]; mp < mri[i+1]; ++mp) { acc.unallow(mci[mp]); }
+                }
+            }
+        }
+    }
+} // namespace impl
+
+/**
+ * Compute C = A*B for two simple_csr_matrix types.
+ *
+ * @param a the matrix A
+ * @param b the matrix B, nrows(b) == ncols(a)
+ * @param ci the row pointer of C, size nrows(a)+1
+ * @param cj the column indices of C, size nnz(C)
+ * @param cv the values of C, size nnz(C)
+ * @param sort_columns if true, the columns of each row are sorted
+ * @param nthreads the number of threads
+ */
+template <class IndexType, class ValueType, class NzSizeType>
+void spgemm(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& a,
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& b,
+    std::vector<NzSizeType>& ci, std::vector<IndexType>& cj,
+    std::vector<ValueType>& cv,
+    bool sort_columns=true, int nthreads=parallel_max_threads())
+{
+    impl::spgemm(a.nrows, b.ncols,
+        (const NzSizeType*)a.ai, (const IndexType*)a.aj, (const ValueType*)a.a,
+        (const NzSizeType*)b.ai, (const IndexType*)b.aj, (const ValueType*)b.a,
+        false, (const NzSizeType*)a.ai, (const IndexType*)a.aj,
+        ci, cj, cv, sort_columns, nthreads);
+}
+
+/**
+ * Compute C = (A*B) .* spones(M) for simple_csr_matrix types.  Only the
+ * pattern of M is used.
+ *
+ * @param a the matrix A
+ * @param b the matrix B, nrows(b) == ncols(a)
+ * @param mask the matrix M, size nrows(a) x ncols(b)
+ * @param ci the row pointer of C, size nrows(a)+1
+ * @param cj the column indices of C, size nnz(C)
+ * @param cv the values of C, size nnz(C)
+ * @param sort_columns if true, the columns of each row are sorted
+ * @param nthreads the number of threads
+ */
+template <class IndexType, class ValueType, class NzSizeType, class MaskValueType>
+void spgemm(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& a,
+    const simple_csr_matrix<IndexType, ValueType, NzSizeType>& b,
+    const simple_csr_matrix<IndexType, MaskValueType, NzSizeType>& mask,
+    std::vector<NzSizeType>& ci, std::vector<IndexType>& cj,
+    std::vector<ValueType>& cv,
+    bool sort_columns=true, int nthreads=parallel_max_threads())
+{
+    impl::spgemm(a.nrows, b.ncols,
+        (const NzSizeType*)a.ai, (const IndexType*)a.aj, (const ValueType*)a.a,
+        (const NzSizeType*)b.ai, (const IndexType*)b.aj, (const ValueType*)b.a,
+        true, (const NzSizeType*)mask.ai, (const IndexType*)mask.aj,
+        ci, cj, cv, sort_columns, nthreads);
+}
+
+/**
+ * Compute C = A*B for two compressed_row_matrix types.  The row
+ * iterators must be random access iterators.
+ *
+ * @param a the matrix A
+ * @param b the matrix B, nrows(b) == ncols(a)
+ * @param ci the row pointer of C, size nrows(a)+1
+ * @param cj the column indices of C, size nnz(C)
+ * @param cv the values of C, size nnz(C)
+ * @param sort_columns if true, the columns of each row are sorted
+ * @param nthreads the number of threads
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class RowIter2, class ColIter2, class ValIter2,
+    class NzSize, class Index, class Value>
+void spgemm(const compressed_row_matrix<RowIter, ColIter, ValIter>& a,
+    const compressed_row_matrix<RowIter2, ColIter2, ValIter2>& b,
+    std::vector<NzSize>& ci, std::vector<Index>& cj, std::vector<Value>& cv,
+    bool sort_columns=true, int nthreads=parallel_max_threads())
+{
+    Index nr = nrows(a), nc = ncols(b);
+    impl::spgemm(nr, nc, a._rstart, a._cstart, a._vstart,
+        b._rstart, b._cstart, b._vstart, false, a._rstart, a._cstart,
+        ci, cj, cv, sort_columns, nthreads);
+}
+
+/**
+ * Compute C = (A*B) .* spones(M) for compressed_row_matrix types.
+ * Only the pattern of M is used.
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class RowIter2, class ColIter2, class ValIter2,
+    class RowIter3, class ColIter3, class ValIter3,
+    class NzSize, class Index, class Value>
+void spgemm(const compressed_row_matrix<RowIter, ColIter, ValIter>& a,
+    const compressed_row_matrix<RowIter2, ColIter2, ValIter2>& b,
+    const compressed_row_matrix<RowIter3, ColIter3, ValIter3>& mask,
+    std::vector<NzSize>& ci, std::vector<Index>& cj, std::vector<Value>& cv,
+    bool sort_columns=true, int nthreads=parallel_max_threads())
+{
+    Index nr = nrows(a), nc = ncols(b);
+    impl::spgemm(nr, nc, a._rstart, a._cstart, a._vstart,
+        b._rstart, b._cstart, b._vstart, true, mask._rstart, mask._cstart,
+        ci, cj, cv, sort_columns, nthreads);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_SPGEMM_OPERATIONS_HPP
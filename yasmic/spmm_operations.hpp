@@ -0,0 +1,376 @@
+#ifndef YASMIC_SPMM_OPERATIONS_HPP
+#define YASMIC_SPMM_OPERATIONS_HPP
+
+/**
+ * @file spmm_operations.hpp
+ * Sparse matrix times dense multi-vector products, Y = A*X and
+ * Y = A^T*X, where X and Y are blocks of k vectors stored by rows (the
+ * k entries for one row are contiguous).
+ *
+ * Calling mult k times streams the matrix from memory k times; spmm
+ * reads each nonzero once and applies it to a whole row of X.  The
+ * kernels are instantiated for each k from 1 to 16 so the loop over
+ * the row of X has a fixed length that the compiler unrolls and
+ * vectorizes.  Larger k are done in strips of 16 columns.
+ *
+ * The rows are split among threads with nnz_balanced_row_partition as
+ * in parallel_mult.  trans_spmm uses a parallel_trans_mult_workspace
+ * to pick between private accumulators and a transposed copy.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cstddef>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/parallel_matrix_operations.hpp>
+#include <yasmic/compressed_row_matrix.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    /**
+     * Call f.apply<K>(j0) for strips [j0,j0+K) covering k columns with
+     * K at most 16.
+     */
+    template <class Kernel>
+    void spmm_for_each_strip(Kernel& f, int k)
+    {
+        int j0 = 0;
+        for (; j0+16 <= k; j0 += 16) { f.template apply<16>(j0); }
+        switch (k - j0)
+        {
+            case 1: f.template apply<1>(j0); break;
+            case 2: f.template apply<2>(j0); break;
+            case 3: f.template apply<3>(j0); break;
+            case 4: f.template apply<4>(j0); break;
+            case 5: f.template apply<5>(j0); break;
+            case 6: f.template apply<6>(j0); break;
+            case 7: f.template apply<7>(j0); break;
+            case 8: f.template apply<8>(j0); break;
+            case 9: f.template apply<9>(j0); break;
+            case 10: f.template apply<10>(j0); break;
+            case 11: f.template apply<11>(j0); break;
+            case 12: f.template apply<12>(j0); break;
+            case 13: f.template apply<13>(j0); break;
+            case 14: f.template apply<14>(j0); break;
+            case 15: f.template apply<15>(j0); break;
+            default: break;
+        }
+    }
+
+    /**
+     * Y(r,j0:j0+K) = A(r,:)*X(:,j0:j0+K) for the rows in [rstart,rend).
+     */
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2>
+    struct csr_spmm_rows
+    {
+        RowIter ri; ColIter ci; ValIter vi;
+        Index rstart, rend;
+        Iter1 x; Iter2 y; int k;
+
+        csr_spmm_rows(RowIter ri, ColIter ci, ValIter vi,
+            Index rstart, Index rend, Iter1 x, Iter2 y, int k)
+            : ri(ri), ci(ci), vi(vi), rstart(rstart), rend(rend),
+              x(x), y(y), k(k) {}
+
+        template <int K>
+        void apply(int j0)
+        {
+            typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+            for (Index r=rstart; r < rend; ++r)
+            {
+                Value acc[K];
+                for (int j=0; j < K; ++j) { acc[j] = Value(); }
+                for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+                {
+                    Value v = vi[cp];
+                    Iter1 xr = x + ((std::ptrdiff_t)ci[cp]*k + j0);
+                    for (int j=0; j < K; ++j) { acc[j] += v*xr[j]; }
+                }
+                Iter2 yr = y + ((std::ptrdiff_t)r*k + j0);
+                for (int j=0; j < K; ++j) { yr[j] = acc[j]; }
+            }
+        }
+    };
+
+    /**
+     * Y(c,j0:j0+K) += A(r,c)*X(r,j0:j0+K) for the rows in [rstart,rend).
+     */
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2>
+    struct csr_trans_spmm_rows
+    {
+        RowIter ri; ColIter ci; ValIter vi;
+        Index rstart, rend;
+        Iter1 x; Iter2 y; int k;
+
+        csr_trans_spmm_rows(RowIter ri, ColIter ci, ValIter vi,
+            Index rstart, Index rend, Iter1 x, Iter2 y, int k)
+            : ri(ri), ci(ci), vi(vi), rstart(rstart), rend(rend),
+              x(x), y(y), k(k) {}
+
+        template <int K>
+        void apply(int j0)
+        {
+            typedef typename std::iterator_traits<RowIter>::value_type nzitype;
+            for (Index r=rstart; r < rend; ++r)
+            {
+                Value xr[K];
+                Iter1 xp = x + ((std::ptrdiff_t)r*k + j0);
+                for (int j=0; j < K; ++j) { xr[j] = xp[j]; }
+                for (nzitype cp = ri[r]; cp < ri[r+1]; ++cp)
+                {
+                    Value v = vi[cp];
+                    Iter2 yc = y + ((std::ptrdiff_t)ci[cp]*k + j0);
+                    for (int j=0; j < K; ++j) { yc[j] += v*xr[j]; }
+                }
+            }
+        }
+    };
+
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2>
+    void csr_spmm(RowIter ri, ColIter ci, ValIter vi,
+        Index rstart, Index rend, Iter1 x, Iter2 y, int k)
+    {
+        csr_spmm_rows<Value, RowIter, ColIter, ValIter, Index, Iter1, Iter2>
+            f(ri, ci, vi, rstart, rend, x, y, k);
+        spmm_for_each_strip(f, k);
+    }
+
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2>
+    void csr_trans_spmm(RowIter ri, ColIter ci, ValIter vi,
+        Index rstart, Index rend, Iter1 x, Iter2 y, int k)
+    {
+        csr_trans_spmm_rows<Value, RowIter, ColIter, ValIter, Index, Iter1, Iter2>
+            f(ri, ci, vi, rstart, rend, x, y, k);
+        spmm_for_each_strip(f, k);
+    }
+
+    template <class Value, class RowIter, class ColIter, class ValIter,
+        class Index, class Iter1, class Iter2>
+    void parallel_csr_spmm(RowIter ri, ColIter ci, ValIter vi, Index nr,
+        Iter1 x, Iter2 y, int k, int nthreads)
+    {
+        if (nthreads < 1) { nthreads = 1; }
+        if (nthreads == 1)
+        {
+            csr_spmm<Value>(ri, ci, vi, (Index)0, nr, x, y, k);
+            return;
+        }
+
+        std::vector<Index> part(nthreads+1);
+        nnz_balanced_row_partition(ri, nr, nthreads, part.begin());
+
+        #pragma omp parallel for schedule(static,1) num_threads(nthreads)
+        for (int p=0; p < nthreads; ++p)
+        {
+            csr_spmm<Value>(ri, ci, vi, part[p], part[p+1], x, y, k);
+        }
+    }
+
+    template <class RowIter, class ColIter, class ValIter, class Index,
+        class Iter1, class Iter2, class Workspace>
+    void parallel_csr_trans_spmm(RowIter ri, ColIter ci, ValIter vi,
+        Index nr, Index nc, Iter1 x, Iter2 y, int k, Workspace& w)
+    {
+        typedef typename std::iterator_traits<ValIter>::value_type vtype;
+
+        std::size_t ny = (std::size_t)nc*(std::size_t)k;
+
+        if (w.strategy == Workspace::undecided_strategy)
+        {
+            w.choose_strategy(nr, nc, ri[nr] - ri[0], k);
+        }
+
+        if (w.strategy == Workspace::transpose_copy_strategy)
+        {
+            if (w.ati.size() != (std::size_t)nc+1)
+            {
+                csr_transpose_copy(ri, ci, vi, nr, nc, w.ati, w.atj, w.atv);
+            }
+            parallel_csr_spmm<vtype>(&w.ati[0],
+                w.atj.empty() ? (const Index*)0 : &w.atj[0],
+                w.atv.empty() ? (const vtype*)0 : &w.atv[0],
+                nc, x, y, k, w.nthreads);
+        }
+        else if (w.strategy == Workspace::private_accumulator_strategy)
+        {
+            int nthreads = w.nthreads;
+            w.acc.resize((std::size_t)nthreads*ny);
+
+            std::vector<Index> part(nthreads+1);
+            nnz_balanced_row_partition(ri, nr, nthreads, part.begin());
+
+            #pragma omp parallel num_threads(nthreads)
+            {
+                #pragma omp for schedule(static,1)
+                for (int p=0; p < nthreads; ++p)
+                {
+                    vtype *acc = &w.acc[(std::size_t)p*ny];
+                    for (std::size_t i=0; i < ny; ++i) { acc[i] = vtype(); }
+                    csr_trans_spmm<vtype>(ri, ci, vi, part[p], part[p+1],
+                        x, acc, k);
+                }
+
+                // reduce the accumulators in a fixed order
+                #pragma omp for schedule(static)
+                for (std::ptrdiff_t i=0; i < (std::ptrdiff_t)ny; ++i)
+                {
+                    vtype sum = vtype();
+                    for (int p=0; p < nthreads; ++p)
+                    {
+                        sum += w.acc[(std::size_t)p*ny + i];
+                    }
+                    y[i] = sum;
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t i=0; i < ny; ++i) { y[i] = vtype(); }
+            csr_trans_spmm<vtype>(ri, ci, vi, (Index)0, nr, x, y, k);
+        }
+    }
+} // namespace impl
+
+/**
+ * Compute Y = A*X for a simple_csr_matrix.
+ *
+ * @param m the matrix A
+ * @param x the input block X, size ncols(m) x k by rows
+ * @param y the output block Y, size nrows(m) x k by rows
+ * @param k the number of vectors
+ * @param nthreads the number of threads
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void spmm(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, int k, int nthreads)
+{
+    impl::parallel_csr_spmm<ValueType>(
+        (const NzSizeType*)m.ai, (const IndexType*)m.aj,
+        (const ValueType*)m.a, m.nrows, x, y, k, nthreads);
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void spmm(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, int k)
+{
+    spmm(m, x, y, k, parallel_max_threads());
+}
+
+/**
+ * Compute Y = A*X for a compressed_row_matrix.  RowIter must be a
+ * random access iterator.
+ *
+ * @param m the matrix A
+ * @param x the input block X, size ncols(m) x k by rows
+ * @param y the output block Y, size nrows(m) x k by rows
+ * @param k the number of vectors
+ * @param nthreads the number of threads
+ */
+template <class RowIter, class ColIter, class ValIter, class Iter1, class Iter2>
+void spmm(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, int k, int nthreads)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+    typedef typename smatrix_traits<matrix>::value_type vtype;
+
+    itype nr = nrows(m);
+
+    impl::parallel_csr_spmm<vtype>(m._rstart, m._cstart, m._vstart, nr,
+        x, y, k, nthreads);
+}
+
+template <class RowIter, class ColIter, class ValIter, class Iter1, class Iter2>
+void spmm(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, int k)
+{
+    spmm(m, x, y, k, parallel_max_threads());
+}
+
+/**
+ * Compute Y = A^T*X for a simple_csr_matrix.
+ *
+ * @param m the matrix A
+ * @param x the input block X, size nrows(m) x k by rows
+ * @param y the output block Y, size ncols(m) x k by rows
+ * @param k the number of vectors
+ * @param w the workspace, reuse it for repeated products with the same
+ *   matrix and k
+ */
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void trans_spmm(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, int k,
+    parallel_trans_mult_workspace<IndexType, ValueType, NzSizeType>& w)
+{
+    impl::parallel_csr_trans_spmm(
+        (const NzSizeType*)m.ai, (const IndexType*)m.aj,
+        (const ValueType*)m.a, m.nrows, m.ncols, x, y, k, w);
+}
+
+template <class IndexType, class ValueType, class NzSizeType,
+    class Iter1, class Iter2>
+void trans_spmm(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& m,
+    Iter1 x, Iter2 y, int k)
+{
+    parallel_trans_mult_workspace<IndexType, ValueType, NzSizeType> w;
+    trans_spmm(m, x, y, k, w);
+}
+
+/**
+ * Compute Y = A^T*X for a compressed_row_matrix.  RowIter must be a
+ * random access iterator.
+ *
+ * @param m the matrix A
+ * @param x the input block X, size nrows(m) x k by rows
+ * @param y the output block Y, size ncols(m) x k by rows
+ * @param k the number of vectors
+ * @param w the workspace, reuse it for repeated products with the same
+ *   matrix and k
+ */
+template <class RowIter, class ColIter, class ValIter,
+    class Iter1, class Iter2, class Workspace>
+void trans_spmm(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, int k, Workspace& w)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+
+    itype nr = nrows(m);
+    itype nc = ncols(m);
+
+    impl::parallel_csr_trans_spmm(m._rstart, m._cstart, m._vstart,
+        nr, nc, x, y, k, w);
+}
+
+template <class RowIter, class ColIter, class ValIter,
+    class Iter1, class Iter2>
+void trans_spmm(const compressed_row_matrix<RowIter, ColIter, ValIter>& m,
+    Iter1 x, Iter2 y, int k)
+{
+    typedef compressed_row_matrix<RowIter, ColIter, ValIter> matrix;
+    typedef typename smatrix_traits<matrix>::index_type itype;
+    typedef typename smatrix_traits<matrix>::value_type vtype;
+
+    parallel_trans_mult_workspace<itype, vtype> w;
+    trans_spmm(m, x, y, k, w);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_SPMM_OPERATIONS_HPP
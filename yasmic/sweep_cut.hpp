@@ -0,0 +1,181 @@
+#ifndef YASMIC_SWEEP_CUT_HPP
+#define YASMIC_SWEEP_CUT_HPP
+
+/**
+ * @file sweep_cut.hpp
+ * The conductance sweep cut of a sparse vector over an undirected graph,
+ * the usual last step of a local clustering method such as ppr_push.
+ *
+ * The support of x is sorted by x(u)/d(u), largest first, and the
+ * vertices are added to S one at a time.  Adding u changes
+ *
+ *   cut(S) by d(u) - 2*|edges from u into S|,  vol(S) by d(u),
+ *
+ * which only needs the neighbors of u and a membership bitmap, so the
+ * sweep takes O(vol(S) + k log k) time for a support of size k.  The
+ * conductance of a prefix is cut(S)/min(vol(S), vol(G) - vol(S)), where
+ * vol(G) = num_edges(g) counts each undirected edge twice.
+ *
+ * The graph must be undirected and stored with both directions of each
+ * edge, the degrees are the number of neighbors, and self loops are not
+ * cut edges.  Vertices in the support without neighbors are skipped.
+ * The bitmap is kept in a sweep_cut_workspace and only the entries of
+ * the support are reset after each sweep.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/graph/graph_traits.hpp>
+
+#include <yasmic/simple_csr_matrix_as_graph.hpp>
+#include <yasmic/semiring_operations.hpp>
+
+namespace yasmic
+{
+
+/**
+ * The result of a sweep.  The set with the smallest conductance is
+ * order[0] ... order[best_size-1].
+ */
+template <class Index>
+struct sweep_cut_result
+{
+    // the vertices by decreasing x(u)/d(u)
+    std::vector<Index> order;
+
+    // the cut, volume and conductance of each prefix of order
+    std::vector<std::size_t> cut;
+    std::vector<std::size_t> volume;
+    std::vector<double> conductance;
+
+    std::size_t best_size;
+    double best_conductance;
+
+    sweep_cut_result() : best_size(0), best_conductance(1.0) {}
+};
+
+/**
+ * The membership bitmap for sweep_cut, keep it between sweeps over the
+ * same graph.
+ */
+struct sweep_cut_workspace
+{
+    std::vector<char> member;
+};
+
+namespace impl
+{
+    template <class Value, class Index>
+    struct sweep_cut_order
+    {
+        bool operator()(const std::pair<Value, Index>& a,
+            const std::pair<Value, Index>& b) const
+        {
+            if (a.first != b.first) { return (a.first > b.first); }
+            return (a.second < b.second);
+        }
+    };
+} // namespace impl
+
+/**
+ * Compute the conductance sweep cut of the sparse vector x.
+ *
+ * @param g the undirected graph
+ * @param x the vector, for example from ppr_push, its indices should be
+ *   distinct
+ * @param res the output profile and best set
+ * @param w the workspace
+ * @return the size of the set with the smallest conductance
+ */
+template <class Graph, class Index, class Value>
+std::size_t sweep_cut(const Graph& g, const sparse_vector<Index, Value>& x,
+    sweep_cut_result<Index>& res, sweep_cut_workspace& w)
+{
+    typedef typename boost::graph_traits<Graph>::adjacency_iterator adj_iter;
+    using boost::num_vertices;
+    using boost::num_edges;
+    using boost::out_degree;
+    using boost::adjacent_vertices;
+
+    std::size_t volg = num_edges(g);
+    if (w.member.size() < (std::size_t)num_vertices(g))
+    {
+        w.member.assign(num_vertices(g), 0);
+    }
+
+    std::vector< std::pair<Value, Index> > scores;
+    scores.reserve(x.size());
+    for (std::size_t i=0; i < x.size(); ++i)
+    {
+        std::size_t d = out_degree(x.ind[i], g);
+        if (d == 0) { continue; }
+        scores.push_back(std::make_pair(x.val[i]/(Value)d, x.ind[i]));
+    }
+    std::sort(scores.begin(), scores.end(), impl::sweep_cut_order<Value, Index>());
+
+    std::size_t k = scores.size();
+    res.order.resize(k);
+    res.cut.resize(k);
+    res.volume.resize(k);
+    res.conductance.resize(k);
+    res.best_size = 0;
+    res.best_conductance = 1.0;
+
+    std::size_t cut = 0, vol = 0;
+    for (std::size_t i=0; i < k; ++i)
+    {
+        Index u = scores[i].second;
+        res.order[i] = u;
+
+        std::size_t internal = 0, loops = 0;
+        adj_iter ai, aend;
+        for (boost::tie(ai, aend) = adjacent_vertices(u, g); ai != aend; ++ai)
+        {
+            if ((Index)*ai == u) { ++loops; }
+            else if (w.member[*ai]) { ++internal; }
+        }
+        std::size_t d = out_degree(u, g);
+        cut = cut + (d - loops) - 2*internal;
+        vol += d;
+        w.member[u] = 1;
+
+        std::size_t denom = std::min(vol, volg - vol);
+        double phi = denom > 0 ? (double)cut/(double)denom : 1.0;
+        res.cut[i] = cut;
+        res.volume[i] = vol;
+        res.conductance[i] = phi;
+        if (res.best_size == 0 || phi < res.best_conductance)
+        {
+            res.best_size = i+1;
+            res.best_conductance = phi;
+        }
+    }
+
+    for (std::size_t i=0; i < k; ++i) { w.member[res.order[i]] = 0; }
+    return (res.best_size);
+}
+
+/**
+ * Compute the conductance sweep cut of the sparse vector x with a
+ * temporary workspace.
+ */
+template <class Graph, class Index, class Value>
+std::size_t sweep_cut(const Graph& g, const sparse_vector<Index, Value>& x,
+    sweep_cut_result<Index>& res)
+{
+    sweep_cut_workspace w;
+    return (sweep_cut(g, x, res, w));
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_SWEEP_CUT_HPP
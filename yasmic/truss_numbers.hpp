@@ -0,0 +1,230 @@
+#ifndef YASMIC_TRUSS_NUMBERS_HPP
+#define YASMIC_TRUSS_NUMBERS_HPP
+
+/**
+ * @file truss_numbers.hpp
+ * The k-truss decomposition of an undirected graph in a
+ * simple_csr_matrix.
+ *
+ * The support of an edge is the number of triangles that contain it.
+ * The k-truss is the largest subgraph where each edge has support at
+ * least k-2, and the truss number of an edge is the largest k-truss
+ * that contains it, so an edge in no triangle has truss number 2.
+ *
+ * The rows must be sorted, with both directions of each edge stored
+ * and no duplicates.  The support of each edge (u,v) with u < v is the
+ * size of the merge intersection of the rows of u and v, computed in
+ * parallel over the rows.  Then the edges are peeled in order of
+ * support with the bucket sort of Batagelj and Zaversnik: removing
+ * (u,v) with support s decrements the support of (u,w) and (v,w) for
+ * each remaining triangle (u,v,w) where it is above s.
+ *
+ * The edges are numbered by their position in aj, the same as
+ * get(edge_index, g) from simple_csr_matrix_as_graph.hpp, and both
+ * directions of an edge get its truss number.  Self loops get zero.
+ * The memory is a few arrays of size nnz.
+ *
+ * J. Wang and J. Cheng, "Truss decomposition in massive networks,"
+ * VLDB 2012.
+ */
+
+/*
+ * 19 October 2026
+ * Initial version
+ */
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+#include <yasmic/parallel_util.hpp>
+#include <yasmic/simple_csr_matrix.hpp>
+
+namespace yasmic
+{
+
+namespace impl
+{
+    /**
+     * Set rev[p] to the position of the edge (v,u) for the edge (u,v)
+     * at position p.
+     */
+    template <class Index, class NzSize>
+    void reverse_edge_index(const NzSize* ai, const Index* aj, Index n,
+        std::vector<NzSize>& rev, int nthreads)
+    {
+        rev.resize(ai[n]);
+
+        #pragma omp parallel for schedule(dynamic,64) num_threads(nthreads)
+        for (Index u=0; u < n; ++u)
+        {
+            for (NzSize p = ai[u]; p < ai[u+1]; ++p)
+            {
+                Index v = aj[p];
+                rev[p] = (NzSize)(std::lower_bound(aj + ai[v], aj + ai[v+1], u) - aj);
+            }
+        }
+    }
+} // namespace impl
+
+/**
+ * Compute the support of each edge, the number of triangles with it.
+ *
+ * @param g the graph with sorted rows
+ * @param support the output, size nnz(g), indexed by edge position
+ * @param nthreads the number of threads
+ */
+template <class IndexType, class ValueType, class NzSizeType, class SupportIter>
+void edge_support(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    SupportIter support, int nthreads=parallel_max_threads())
+{
+    const NzSizeType *ai = g.ai;
+    const IndexType *aj = g.aj;
+    IndexType n = g.nrows;
+
+    if (nthreads < 1) { nthreads = 1; }
+
+    #pragma omp parallel for schedule(dynamic,64) num_threads(nthreads)
+    for (IndexType u=0; u < n; ++u)
+    {
+        for (NzSizeType p = ai[u]; p < ai[u+1]; ++p)
+        {
+            IndexType v = aj[p];
+            if (v == u) { support[p] = 0; continue; }
+
+            // the merge intersection of the two rows
+            NzSizeType cnt = 0;
+            NzSizeType pu = ai[u], pv = ai[v];
+            while (pu < ai[u+1] && pv < ai[v+1])
+            {
+                IndexType wu = aj[pu], wv = aj[pv];
+                if (wu < wv) { ++pu; }
+                else if (wv < wu) { ++pv; }
+                else
+                {
+                    if (wu != u && wu != v) { ++cnt; }
+                    ++pu;
+                    ++pv;
+                }
+            }
+            support[p] = cnt;
+        }
+    }
+}
+
+/**
+ * Compute the truss number of each edge.
+ *
+ * @param g the graph with sorted rows
+ * @param truss the output, size nnz(g), indexed by edge position
+ * @param nthreads the number of threads for the support
+ * @return the largest truss number
+ */
+template <class IndexType, class ValueType, class NzSizeType, class TrussIter>
+NzSizeType truss_numbers(const simple_csr_matrix<IndexType, ValueType, NzSizeType>& g,
+    TrussIter truss, int nthreads=parallel_max_threads())
+{
+    const NzSizeType *ai = g.ai;
+    const IndexType *aj = g.aj;
+    IndexType n = g.nrows;
+    NzSizeType nz = ai[n];
+
+    if (nthreads < 1) { nthreads = 1; }
+
+    std::vector<NzSizeType> sup(nz), rev;
+    edge_support(g, sup.begin(), nthreads);
+    impl::reverse_edge_index(ai, aj, n, rev, nthreads);
+
+    // bucket sort the edges (u,v) with u < v by support
+    NzSizeType maxsup = 0;
+    NzSizeType nedges = 0;
+    for (IndexType u=0; u < n; ++u)
+    {
+        for (NzSizeType p = ai[u]; p < ai[u+1]; ++p)
+        {
+            if (aj[p] <= u) { truss[p] = 0; continue; }
+            ++nedges;
+            if (sup[p] > maxsup) { maxsup = sup[p]; }
+        }
+    }
+    std::vector<NzSizeType> bin(maxsup+2, 0), pos(nz), edge(nedges);
+    for (IndexType u=0; u < n; ++u)
+    {
+        for (NzSizeType p = ai[u]; p < ai[u+1]; ++p)
+        {
+            if (aj[p] > u) { ++bin[sup[p]+1]; }
+        }
+    }
+    for (NzSizeType s=0; s <= maxsup; ++s) { bin[s+1] += bin[s]; }
+    {
+        std::vector<NzSizeType> next(bin.begin(), bin.end()-1);
+        for (IndexType u=0; u < n; ++u)
+        {
+            for (NzSizeType p = ai[u]; p < ai[u+1]; ++p)
+            {
+                if (aj[p] <= u) { continue; }
+                pos[p] = next[sup[p]]++;
+                edge[pos[p]] = p;
+            }
+        }
+    }
+
+    // the source vertex of each edge, and the removed edges
+    std::vector<IndexType> src(nz);
+    for (IndexType u=0; u < n; ++u)
+    {
+        for (NzSizeType p = ai[u]; p < ai[u+1]; ++p) { src[p] = u; }
+    }
+    std::vector<char> removed(nz, 0);
+
+    NzSizeType kmax = 2;
+    for (NzSizeType i=0; i < nedges; ++i)
+    {
+        NzSizeType e = edge[i];
+        IndexType u = src[e], v = aj[e];
+        NzSizeType s = sup[e];
+        truss[e] = s + 2;
+        truss[rev[e]] = s + 2;
+        if (s + 2 > kmax) { kmax = s + 2; }
+        removed[e] = 1;
+
+        // the remaining triangles (u,v,w)
+        NzSizeType pu = ai[u], pv = ai[v];
+        while (pu < ai[u+1] && pv < ai[v+1])
+        {
+            IndexType wu = aj[pu], wv = aj[pv];
+            if (wu < wv) { ++pu; continue; }
+            if (wv < wu) { ++pv; continue; }
+            NzSizeType e1 = wu > u ? pu : rev[pu];
+            NzSizeType e2 = wv > v ? pv : rev[pv];
+            ++pu;
+            ++pv;
+            if (wu == u || wu == v || removed[e1] || removed[e2]) { continue; }
+
+            NzSizeType es[2] = {e1, e2};
+            for (int k=0; k < 2; ++k)
+            {
+                NzSizeType f = es[k];
+                if (sup[f] <= s) { continue; }
+                // move f to the front of its bucket, then shrink it
+                NzSizeType sf = sup[f];
+                NzSizeType pf = pos[f], pw = bin[sf];
+                NzSizeType w = edge[pw];
+                if (w != f)
+                {
+                    pos[f] = pw;
+                    pos[w] = pf;
+                    edge[pw] = f;
+                    edge[pf] = w;
+                }
+                ++bin[sf];
+                --sup[f];
+            }
+        }
+    }
+    return (kmax);
+}
+
+} // namespace yasmic
+
+#endif // YASMIC_TRUSS_NUMBERS_HPP